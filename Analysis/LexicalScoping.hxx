@@ -31,6 +31,7 @@ inline std::string stringify(const std::vector<std::string>& spaces) {
 
 struct NameSpace {
     std::string name;
+    size_t slot{}; // where the interpreter keeps its variables
 
     NameSpace *parent = nullptr;
     std::vector<std::shared_ptr<NameSpace>> children;
@@ -47,6 +48,11 @@ struct LexicalAnalysis {
     std::unordered_map<std::string, std::unordered_map<std::string, size_t>> namespaces;
     std::string space_dir;
     std::vector<std::shared_ptr<NameSpace>> global_spaces;
+    size_t space_index{};
+
+    // the slot of the space every member was defined in, by the member's ID.
+    // Names resolved to a member carry that slot, so the interpreter finds a member `use space` brought in without searching for it
+    std::unordered_map<size_t, ssize_t> member_slots;
 
 
     bool in_loop = false;
@@ -98,11 +104,14 @@ struct LexicalAnalysis {
             "__builtin_set",
             "__builtin_conditional",
             "__builtin_str_slice",
-            // //* File IO
-            // "__builtin_read_file",
-            // "__builtin_read_whole",
-            // "__builtin_read_line",
-            // "__builtin_read_lines"
+            //* File IO
+            "__builtin_read_file",
+            "__builtin_read_whole",
+            "__builtin_read_lines",
+            "__builtin_read_line",
+            "__builtin_has_line",
+            "__builtin_write_file",
+            "__builtin_append_file",
         };
 
 
@@ -163,6 +172,8 @@ struct LexicalAnalysis {
         const auto space = findSpace(acc->spaces, acc->global);
         if (not space) util::error("Namespace `" + stringify(acc->spaces) + "` is expression `" + ass->stringify() + "` was not found!");
 
+        acc->slot = space->slot;
+
         for (const auto& [var, id] : namespaces[fullName(space)]) {
             if (var == acc->name.name) {
                 acc->name.ID = id;
@@ -193,7 +204,7 @@ struct LexicalAnalysis {
                 addVar(ass->lhs->stringify(), ass->lhs->ID);
             }
             else if (const auto id = findVar(ass->lhs->stringify()); id) {
-                ass->lhs->ID = *id;
+                resolve(*ass->lhs, *id);
             }
             else {
                 ass->lhs->ID = variable_index++;
@@ -203,7 +214,7 @@ struct LexicalAnalysis {
 
         std::visit(*this, ass->rhs->variant());
         if (const auto id = findVar(ass->type->text()); id) {
-            ass->type->ID = *id;
+            resolve(*ass->type, *id);
         }
         else std::visit(*this, expr::Type{ass->type}.variant());
 
@@ -215,7 +226,7 @@ struct LexicalAnalysis {
                 addVar(ass->lhs->stringify(), ass->lhs->ID);
             }
             else if (const auto id = findVar(ass->lhs->stringify()); id) {
-                ass->lhs->ID = *id;
+                resolve(*ass->lhs, *id);
             }
             else { // I could probably shorten this to only use an "if-else" and not "if-elif-else"
                 ass->lhs->ID = variable_index++;
@@ -227,7 +238,7 @@ struct LexicalAnalysis {
 
     void operator()(expr::Name *name) {
         if (const auto id = findVar(name->name)) {
-            name->ID = *id;
+            resolve(*name, *id);
             return;
         }
 
@@ -260,7 +271,7 @@ struct LexicalAnalysis {
 
             if (auto expr_type = type::isExpr(type)) {
                 if (const auto id = findVar(type->text()); id)
-                    expr_type->t->ID = *id;
+                    resolve(*expr_type->t, *id);
             }
 
             name.ID = variable_index++;
@@ -269,6 +280,8 @@ struct LexicalAnalysis {
 
         std::visit(*this, expr::Type{c->type.ret}.variant());
 
+        c->dependencies(); // so calls don't have to look through the types
+
         std::visit(*this, c->body->variant());
     }
 
@@ -286,6 +299,10 @@ struct LexicalAnalysis {
 
         for (const auto& arg : call->args)
             std::visit(*this, arg->variant());
+
+        call->positional = call->named_args.empty() and std::ranges::none_of(call->args, [] (const auto& arg) {
+            return dynamic_cast<const expr::Expansion*>(arg.get());
+        });
     }
 
     void operator()(expr::List *list) {
@@ -381,7 +398,7 @@ struct LexicalAnalysis {
 
         for (auto& type : onion->types) {
             if (const auto id = findVar(type->text()); id)
-                type->ID = *id;
+                resolve(*type, *id);
 
             else std::visit(*this, expr::Type{type}.variant());
 
@@ -423,11 +440,14 @@ struct LexicalAnalysis {
             // if (not pattern.name.empty()) addVar(pattern.name);
         }
         else { // holds expr::Match::Case::Pattern::Structure
-            auto& [name, patterns] = get<expr::Match::Case::Pattern::Structure>(pat.pattern);
+            auto& [name, patterns, space] = get<expr::Match::Case::Pattern::Structure>(pat.pattern);
 
             if (const auto id = findVar(name.name); not id)
                 util::error<except::NameLookup>("Name `" + name.name + "` not found!");
-            else name.ID = *id;
+            else {
+                name.ID = *id;
+                space = memberSpace(*id);
+            }
 
             for (const auto& pat : patterns) checkPattern(*pat);
         }
@@ -516,27 +536,8 @@ struct LexicalAnalysis {
     }
 
 
-    void operator()(expr::Import *import) {
-        if (auto id = findVar(import->stringify())) {
-            import->ID = *id;
-            return;
-        }
-
-        if (findVar(import->stringify())) return;
-        else util::error();
-
-
-        // const auto src = util::readFile(auto{import->path}.replace_extension(".pie").string());
-        // const Tokens v = lex::lex(src);
-        // if (v.empty()) util::error("Can't import an empty file!");
-
-        // Parser p{v, import->path};
-
-        // auto [exprs, _] = p.parse();
-
-        // for (const auto& expr : exprs)
-        //     std::visit(*this, std::move(expr)->variant());
-    }
+    // modules are analysed in their own scope when they're loaded (see Utils/Module.hxx)
+    void operator()(expr::Import *) {}
 
 
     void operator()(expr::Namespace *ns) {
@@ -546,6 +547,7 @@ struct LexicalAnalysis {
         }
 
         addSpace(ns->name);
+        ns->slot = getNamespaceAt(space_dir, global_spaces)->slot;
 
         for (const auto& expr : ns->space)
             std::visit(*this, expr->variant());
@@ -564,23 +566,22 @@ struct LexicalAnalysis {
         auto space = findSpace(use->spaces, use->global);
         if (not space) util::error();
 
+        use->slot = space->slot;
+
         for (const auto& [var, id] : namespaces[fullName(space)]) {
             addVar(var, id);
             use->last_item_id = id;
         }
 
         // pull child namespaces into the parent's
+        // they're the same nodes, so the short names lead to the same slots as the full ones
         if (space->parent) {
-            for (auto& child : space->children) {
+            for (auto& child : space->children)
                 space->parent->children.push_back(child);
-                use->children.push_back({fullName(child.get()), child->name});
-            }
         }
         else {
-            for (auto& child : space->children) {
+            for (auto& child : space->children)
                 global_spaces.push_back(child);
-                use->children.push_back({fullName(child.get()), child->name});
-            }
         }
 
 
@@ -596,6 +597,8 @@ struct LexicalAnalysis {
         const auto space = findSpace(use->spaces, use->global);
         if (not space) util::error();
 
+        use->slot = space->slot;
+
         for (const auto& [var, id] : namespaces[fullName(space)]) {
             if (var == use->name.name) {
                 use->name.ID = id;
@@ -613,6 +616,8 @@ struct LexicalAnalysis {
 
         if (not space) util::error();
 
+        acc->slot = space->slot;
+
         for (const auto& [var, id] : namespaces[fullName(space)]) {
             if (var == acc->name.name) {
                 acc->name.ID = id;
@@ -694,12 +699,12 @@ struct LexicalAnalysis {
             else if (const auto s = dynamic_cast<const expr::String*>(expr_type->t.get()));
 
             else if (const auto id = findVar(type->text()); id) {
-                expr_type->ID = *id;
-                expr_type->t->ID = *id;
+                resolve(*expr_type, *id);
+                resolve(*expr_type->t, *id);
             }
             else if (auto unio = dynamic_cast<expr::Union*>(expr_type->t.get())) {
                 for (auto& type : unio->types) {
-                    if (const auto id = findVar(type->text()); id) type->ID = *id;
+                    if (const auto id = findVar(type->text()); id) resolve(*type, *id);
                     else visitType(type);
                 }
             }
@@ -718,8 +723,8 @@ struct LexicalAnalysis {
 
     void operator()(expr::Type *type) {
         if (auto id = findVar(type->stringify())) {
-            type->ID = *id;
-            type->type->ID = *id;
+            resolve(*type, *id);
+            resolve(*type->type, *id);
             return;
         }
 
@@ -787,7 +792,17 @@ struct LexicalAnalysis {
         const auto parent = getNamespaceAt(space_dir, global_spaces);
 
         if (not parent) {
-            global_spaces.push_back({std::make_shared<NameSpace>(std::move(name))});
+            // reopening a space should land in the same slot
+            // spaces pulled out by `use space` are skipped, they're still children of their parent
+            for (size_t i{}; const auto& ns : global_spaces) {
+                if (ns->name == name and not ns->parent) {
+                    space_dir += std::to_string(i);
+                    return;
+                }
+                ++i;
+            }
+
+            global_spaces.push_back({std::make_shared<NameSpace>(name, space_index++)});
             space_dir += std::to_string(global_spaces.size() - 1);
             namespaces[name];
             return;
@@ -804,7 +819,7 @@ struct LexicalAnalysis {
         }
 
         // not found, add it
-        parent->children.push_back({std::make_unique<NameSpace>(name)});
+        parent->children.push_back({std::make_unique<NameSpace>(name, space_index++)});
         parent->children.back()->parent = parent;
 
 
@@ -896,10 +911,24 @@ struct LexicalAnalysis {
         else {
             const auto space = getNamespaceAt(space_dir, global_spaces);
             namespaces[fullName(space)][std::move(name)] = index;
+            member_slots.try_emplace(index, space->slot); // a space that uses another doesn't become the members' home
         }
     }
 
 
+    ssize_t memberSpace(const size_t id) const {
+        const auto it = member_slots.find(id);
+        return it == member_slots.end() ? -1 : it->second;
+    }
+
+    // gives `node` the ID, and the space it's a member of (if it is one)
+    template <typename Node>
+    void resolve(Node& node, const size_t id) const {
+        node.ID = id;
+        node.space = memberSpace(id);
+    }
+
+
     std::optional<size_t> findVarInSpace(const std::string& name) const {
         const auto* space = getNamespaceAt(space_dir, global_spaces);
 
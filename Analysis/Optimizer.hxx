@@ -0,0 +1,805 @@
+#pragma once
+
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <memory>
+#include <variant>
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <format>
+#include <tuple>
+#include <cmath>
+#include <iostream>
+#include <print>
+
+#include "../Utils/utils.hxx"
+#include "../Utils/Module.hxx"
+#include "../Expr/Expr.hxx"
+#include "../Type/Type.hxx"
+#include "../Interp/Value.hxx"
+
+
+inline namespace pie {
+namespace analysis {
+
+
+// -O0 turns every pass off, -O1 (the default) runs them all
+inline int& optimization() {
+    static int level = 1;
+    return level;
+}
+
+// -opt-report: what the passes did goes to stderr
+inline bool& optimizationReport() {
+    static bool report = false;
+    return report;
+}
+
+
+
+// * walking the AST * //
+// calls `f` on every expression slot right under a node. They're references, so a pass can swap what's in them
+template <typename F>
+struct Children {
+    F f;
+
+    void operator()(expr::List *list) { for (auto& e : list->elements) f(e); }
+    void operator()(expr::Map  *map ) { for (auto& [key, value] : map->items) f(key), f(value); }
+
+    void operator()(expr::Expansion          *e   ) { f(e->pack); }
+    void operator()(expr::UnaryFold          *fold) { f(fold->pack); }
+    void operator()(expr::SeparatedUnaryFold *fold) { f(fold->lhs), f(fold->rhs); }
+    void operator()(expr::BinaryFold         *fold) { f(fold->pack), f(fold->init), f(fold->sep); }
+
+    // the names being assigned to aren't read, only the objects being assigned into are
+    void operator()(expr::Assignment *ass) {
+        if (const auto acc = dynamic_cast<expr::Access*>(ass->lhs.get())) f(acc->var);
+        f(ass->rhs);
+    }
+
+    void operator()(expr::Class *cls) { for (auto& [_, __, e] : cls->fields) f(e); }
+
+    void operator()(expr::Match *match) {
+        f(match->expr);
+
+        for (auto& kase : match->cases) {
+            pattern(*kase.pattern);
+            f(kase.guard);
+            f(kase.body);
+        }
+    }
+
+    void pattern(expr::Match::Case::Pattern& pat) {
+        if (auto single = std::get_if<expr::Match::Case::Pattern::Single>(&pat.pattern)) f(single->value);
+        else for (const auto& p : get<expr::Match::Case::Pattern::Structure>(pat.pattern).patterns) pattern(*p);
+    }
+
+    void operator()(expr::Loop     *loop) { f(loop->kind), f(loop->body), f(loop->els); }
+    void operator()(expr::Break    *br  ) { f(br->expr); }
+    void operator()(expr::Continue *cont) { f(cont->expr); }
+
+    void operator()(expr::Access    *acc) { f(acc->var); }
+    void operator()(expr::Cascade   *cas) { f(cas->var); for (auto& e : cas->members) f(e); }
+    void operator()(expr::Namespace *ns ) { for (auto& e : ns->space) f(e); }
+
+    void operator()(expr::Grouping *group) { f(group->expr); }
+    void operator()(expr::UnaryOp  *up   ) { f(up->expr); }
+    void operator()(expr::BinOp    *bp   ) { f(bp->lhs), f(bp->rhs); }
+    void operator()(expr::PostOp   *pp   ) { f(pp->expr); }
+    void operator()(expr::CircumOp *cp   ) { f(cp->expr); }
+    void operator()(expr::OpCall   *oc   ) { for (auto& e : oc->exprs) f(e); }
+
+    void operator()(expr::Call *call) {
+        f(call->func);
+        for (auto& [_, e] : call->named_args) f(e);
+        for (auto& e : call->args) f(e);
+    }
+
+    void operator()(expr::Closure *c) { f(c->body); }
+    void operator()(expr::Block *b) { for (auto& e : b->lines) f(e); }
+
+    void operator()(expr::Prefix   *fix) { operators(fix); }
+    void operator()(expr::Infix    *fix) { operators(fix); }
+    void operator()(expr::Suffix   *fix) { operators(fix); }
+    void operator()(expr::Exfix    *fix) { operators(fix); }
+    void operator()(expr::Operator *fix) { operators(fix); }
+
+    void operators(expr::Fix *fix) { for (auto& e : fix->funcs) f(e); }
+
+    // literals, names, types, and the `use`s. Imported modules are optimized on their own when they're loaded
+    void operator()(auto *) {}
+};
+
+template <typename F>
+Children(F) -> Children<F>;
+
+
+// pre-order: `f` sees a node before anything under it
+template <typename F>
+void walk(expr::ExprPtr& e, F&& f) {
+    if (not e) return;
+
+    f(e);
+    std::visit(Children{[&f] (expr::ExprPtr& child) { walk(child, f); }}, e->variant());
+}
+
+
+
+// ID -> how many times something is assigned to it, anywhere in the program
+using Assignments = std::unordered_map<ssize_t, size_t>;
+
+inline Assignments assignmentsIn(std::vector<expr::ExprPtr>& exprs) {
+    Assignments assignments;
+
+    for (auto& e : exprs) walk(e, [&assignments] (const expr::ExprPtr& e) {
+        if (const auto ass = dynamic_cast<const expr::Assignment*>(e.get())) {
+            // names, and types like in `:Int = 4;`
+            if (not dynamic_cast<const expr::Access*>(ass->lhs.get())) ++assignments[ass->lhs->ID];
+        }
+
+        // resetting a name unbinds it. Good as reassigning it
+        else if (const auto call = dynamic_cast<const expr::Call*>(e.get()); call and call->func->stringify() == "__builtin_reset") {
+            for (const auto& arg : call->args) assignments[arg->ID] += 2;
+        }
+    });
+
+    return assignments;
+}
+
+
+// a builtin's name that still means the builtin
+inline bool isBuiltin(const expr::Name& name, const Assignments& assignments) {
+    return name.name.starts_with("__builtin_") and not assignments.contains(name.ID);
+}
+
+
+
+// * Syntax parameters * //
+// a closure that takes `Syntax` (or returns it) sees the expressions themselves, not their values,
+// so rewriting what it's passed would change what it sees
+
+// `Syntax`, `...Syntax`, or a union with it in there
+inline bool syntaxType(const type::TypePtr& t) {
+    if (type::isSyntax(t)) return true;
+
+    if (const auto v = dynamic_cast<const type::VariadicType*>(t.get())) return syntaxType(v->type);
+    if (const auto u = dynamic_cast<const type::UnionType   *>(t.get())) return std::ranges::any_of(u->types, syntaxType);
+
+    return false;
+}
+
+
+// `import name` expressions are only parsed when they're evaluated, so their modules are checked by their tokens.
+// a module that can't be loaded is assumed to take Syntax, that's the safe side
+inline bool moduleTakesSyntax(const std::filesystem::path& path, std::unordered_set<std::string>& seen) try {
+    const util::QuietErrors quiet; // it's reported when (if) it's evaluated
+
+    if (not seen.insert(modules::canonicalName(path)).second) return false;
+
+    const auto& tokens = modules::load(path);
+    for (size_t i{}; i < tokens.size(); ++i) {
+        if (tokens[i].kind == TokenKind::NAME and tokens[i].text == "Syntax") return true;
+
+        // nested imports are already absolute
+        if (tokens[i].kind == TokenKind::IMPORT and i + 1 < tokens.size() and moduleTakesSyntax(tokens[i + 1].text, seen)) return true;
+    }
+
+    return false;
+}
+catch (const std::exception&) {
+    return true;
+}
+
+
+// whether any closure or operator in the program, or in a module it imports, has a `Syntax` parameter or return type.
+// top level `import name;`s are already spliced in, so only `import name` expressions need their modules looked at
+inline bool takesSyntax(std::vector<expr::ExprPtr>& exprs) {
+    bool syntax = false;
+    std::unordered_set<std::string> seen;
+
+    for (auto& e : exprs) walk(e, [&syntax, &seen] (const expr::ExprPtr& e) {
+        if (syntax) return;
+
+        if (const auto c = dynamic_cast<const expr::Closure*>(e.get()))
+            syntax = std::ranges::any_of(c->type.params, syntaxType) or (c->type.ret and syntaxType(c->type.ret));
+
+        else if (const auto import = dynamic_cast<const expr::Import*>(e.get()))
+            syntax = moduleTakesSyntax(import->path, seen);
+    });
+
+    return syntax;
+}
+
+
+
+// * constant folding * //
+// unbound literals: they evaluate to the same thing every time
+inline bool isLiteral(const expr::ExprPtr& expr) {
+    return expr->ID < 0 and (
+        dynamic_cast<const expr::Num   *>(expr.get()) or
+        dynamic_cast<const expr::String*>(expr.get()) or
+        dynamic_cast<const expr::Bool  *>(expr.get())
+    );
+}
+
+
+// what a literal evaluates to. Same as the interpreter does it
+inline Value literalValue(const expr::ExprPtr& expr) {
+    if (const auto num = dynamic_cast<const expr::Num*>(expr.get())) {
+        if (num->num.find('.') != std::string::npos) return std::stod(num->num);
+        else return std::stoll(num->num);
+    }
+
+    if (const auto b = dynamic_cast<const expr::Bool*>(expr.get())) return b->boolean;
+
+    return dynamic_cast<const expr::String&>(*expr).str;
+}
+
+
+// the literal that evaluates to `value`, or null if there's none
+inline expr::ExprPtr literal(const Value& value) {
+    if (const auto i = std::get_if<BigInt>(&value)) return std::make_shared<expr::Num>(std::to_string(*i));
+
+    if (const auto d = std::get_if<double>(&value)) {
+        if (not std::isfinite(*d)) return nullptr;
+
+        // shortest text that reads back as the same double. The lexer doesn't do exponents
+        auto text = std::format("{}", *d);
+        if (text.contains('e')) return nullptr;
+        if (not text.contains('.')) text += ".0";
+
+        return std::make_shared<expr::Num>(std::move(text));
+    }
+
+    if (const auto b = std::get_if<bool>(&value)) return std::make_shared<expr::Bool>(*b);
+    if (const auto s = std::get_if<std::string>(&value)) return std::make_shared<expr::String>(*s);
+
+    return nullptr;
+}
+
+
+inline std::string_view typeName(const Value& value) {
+    if (std::holds_alternative<BigInt     >(value)) return "Int";
+    if (std::holds_alternative<double     >(value)) return "Double";
+    if (std::holds_alternative<bool       >(value)) return "Bool";
+    if (std::holds_alternative<std::string>(value)) return "String";
+
+    return "";
+}
+
+
+// the builtins below only depend on their arguments. Calls to them on literals become literals,
+// top level names that are bound to a literal once and never again become that literal,
+// conditionals and matches on literals lose the branches they can't take,
+// and operators that only forward to one of the builtins get folded like the builtin would.
+// `Interpreter` is only there so the builtins are called the exact same way the interpreter calls them
+template <typename Interpreter>
+struct ConstantFolder {
+    Assignments assignments;
+
+    struct Constant {
+        std::string name;
+        expr::ExprPtr value;
+        size_t uses{};
+    };
+
+    std::unordered_map<ssize_t, Constant> constants;
+    std::vector<ssize_t> bound; // the constants, in order
+
+    struct Forwarder {
+        const expr::Closure *func;
+        std::string builtin; // without the "__builtin_"
+    };
+
+    std::unordered_map<std::string, Forwarder> operators;
+
+    std::vector<std::string> lines; // the report
+
+    std::optional<Interpreter> interp;
+
+
+    void operator()(std::vector<expr::ExprPtr>& exprs) {
+        if (takesSyntax(exprs)) return;
+
+        assignments = assignmentsIn(exprs);
+
+        // how many times each operator is defined. Imported modules define them too
+        std::unordered_map<std::string, size_t> fixes;
+        bool imports = false;
+
+        for (auto& e : exprs) walk(e, [&fixes, &imports] (const expr::ExprPtr& e) {
+            if (const auto fix = dynamic_cast<const expr::Fix*>(e.get())) ++fixes[fix->name];
+            imports = imports or dynamic_cast<const expr::Import*>(e.get());
+        });
+
+        // in order, so names and operators only get folded after they're bound
+        for (auto& e : exprs) {
+            fold(e);
+
+            if (const auto fix = dynamic_cast<const expr::Fix*>(e.get()); fix and not imports and fixes[fix->name] == 1)
+                defineOperator(*fix);
+
+            bind(*e);
+        }
+
+        for (const auto ID : bound) {
+            const auto& [name, _, uses] = constants.at(ID);
+            if (uses) lines.push_back(std::format("propagated `{}` to {} use{}", name, uses, uses == 1 ? "" : "s"));
+        }
+    }
+
+
+    [[nodiscard]] std::vector<std::string> report() const { return lines; }
+
+
+    // `name = literal;` at the top level
+    void bind(const expr::Expr& e) {
+        const auto ass = dynamic_cast<const expr::Assignment*>(&e);
+        if (not ass or not dynamic_cast<const expr::Name*>(ass->lhs.get()) or not isLiteral(ass->rhs)) return;
+
+        const auto ID = ass->lhs->ID;
+        if (assignments[ID] != 1 or not accepts(ass->type, literalValue(ass->rhs))) return;
+
+        constants[ID] = {ass->lhs->stringify(), ass->rhs, 0};
+        bound.push_back(ID);
+    }
+
+
+    // `infix(+) + = (a, b) => __builtin_add(a, b);`
+    void defineOperator(const expr::Fix& fix) {
+        if (fix.funcs.size() != 1) return;
+
+        const auto func = dynamic_cast<const expr::Closure*>(fix.funcs[0].get());
+        if (not func) return;
+
+        const auto call = dynamic_cast<const expr::Call*>(func->body.get());
+        if (not call or not call->named_args.empty() or call->args.size() != func->params.size()) return;
+
+        const auto callee = dynamic_cast<const expr::Name*>(call->func.get());
+        if (not callee or not isBuiltin(*callee, assignments)) return;
+
+        for (size_t i{}; i < call->args.size(); ++i)
+            if (not dynamic_cast<const expr::Name*>(call->args[i].get()) or call->args[i]->ID != func->params[i].ID) return;
+
+        operators[fix.name] = {func, callee->name.substr(10)};
+    }
+
+
+    // whether `type` takes `value` without needing the interpreter to tell
+    bool accepts(const type::TypePtr& type, const Value& value) {
+        if (type::shouldReassign(type)) return true;
+
+        if (not type::isBuiltin(type) or assignments.contains(type->ID)) return false;
+
+        return type->text() == "Any" or type->text() == typeName(value);
+    }
+
+
+
+    void fold(expr::ExprPtr& e) {
+        if (not e) return;
+
+        // the members are looked up in the object
+        if (dynamic_cast<const expr::Cascade*>(e.get())) return;
+
+        if (const auto call = dynamic_cast<const expr::Call*>(e.get())) {
+            // those look at the expressions they're passed, not their values
+            const auto name = call->func->stringify();
+            if (name == "__builtin_reset" or name == "__builtin_eval") return;
+        }
+
+        std::visit(Children{[this] (expr::ExprPtr& child) { fold(child); }}, e->variant());
+
+        if (const auto name = dynamic_cast<const expr::Name*>(e.get())) {
+            if (const auto it = constants.find(name->ID); it != constants.end()) {
+                e = it->second.value->left();
+                ++it->second.uses;
+            }
+
+            return;
+        }
+
+        if (e->ID >= 0) return; // the node's text names a variable
+
+        auto folded = std::visit([this] (auto *node) { return simplify(node); }, e->variant());
+        if (not folded) return;
+
+        lines.push_back(std::format("folded `{}` to `{}`", e->stringify(), folded->stringify()));
+        e = std::move(folded);
+    }
+
+
+    expr::ExprPtr simplify(expr::Grouping *group) { return isLiteral(group->expr) ? group->expr : nullptr; }
+
+
+    expr::ExprPtr simplify(expr::Call *call) {
+        const auto callee = dynamic_cast<const expr::Name*>(call->func.get());
+        if (not callee or not isBuiltin(*callee, assignments) or not call->named_args.empty()) return nullptr;
+
+        const auto name = std::string_view{callee->name}.substr(10);
+        const auto& args = call->args;
+
+        if (args.empty() or not isLiteral(args[0])) return nullptr;
+
+        // the lazy ones only need their first argument
+        if (name == "conditional" and args.size() == 3) {
+            const auto cond = literalValue(args[0]);
+            return std::holds_alternative<bool>(cond) and get<bool>(cond) ? args[1] : args[2];
+        }
+
+        if (name == "and" and args.size() == 2) {
+            const auto first = literalValue(args[0]);
+            return std::holds_alternative<bool>(first) and get<bool>(first) ? args[1] : args[0];
+        }
+
+        if (name == "or" and args.size() == 2) {
+            const auto first = literalValue(args[0]);
+            return std::holds_alternative<bool>(first) and get<bool>(first) ? args[0] : args[1];
+        }
+
+
+        if (not std::ranges::all_of(args, isLiteral)) return nullptr;
+
+        std::vector<Value> values;
+        for (const auto& arg : args) values.push_back(literalValue(arg));
+
+        if (name == "concat") {
+            if (values.size() < 2 or not std::ranges::all_of(values, [] (const auto& v) { return std::holds_alternative<std::string>(v); }))
+                return nullptr;
+
+            std::string s;
+            for (const auto& v : values) s += get<std::string>(v);
+
+            return std::make_shared<expr::String>(std::move(s));
+        }
+
+        return call_(name, values);
+    }
+
+
+    // operators that forward to a builtin, on literals
+    expr::ExprPtr simplify(expr::UnaryOp *up) { return apply(up->op, {up->expr}); }
+    expr::ExprPtr simplify(expr::BinOp   *bp) { return apply(bp->op, {bp->lhs, bp->rhs}); }
+    expr::ExprPtr simplify(expr::PostOp  *pp) { return apply(pp->op, {pp->expr}); }
+
+    expr::ExprPtr apply(const std::string& op, const std::vector<expr::ExprPtr>& operands) {
+        const auto it = operators.find(op);
+        if (it == operators.end() or not std::ranges::all_of(operands, isLiteral)) return nullptr;
+
+        const auto& [func, builtin] = it->second;
+        if (func->params.size() != operands.size()) return nullptr;
+
+        std::vector<Value> values;
+        for (size_t i{}; i < operands.size(); ++i) {
+            values.push_back(literalValue(operands[i]));
+
+            if (not accepts(func->type.params[i], values.back())) return nullptr;
+        }
+
+        auto folded = call_(builtin, values);
+        if (not folded or not accepts(func->type.ret, literalValue(folded))) return nullptr;
+
+        return folded;
+    }
+
+
+    // drops the cases a literal can't match, and the ones after the first it's sure to match
+    expr::ExprPtr simplify(expr::Match *match) {
+        if (not isLiteral(match->expr)) return nullptr;
+
+        const auto value = literalValue(match->expr);
+
+        std::vector<expr::Match::Case> cases;
+        size_t i{};
+
+        for (; i < match->cases.size(); ++i) {
+            auto& kase = match->cases[i];
+            const auto matches = matchesLiteral(*kase.pattern, value);
+
+            if (matches == Maybe::no) continue;
+
+            cases.push_back(std::move(kase));
+
+            // past this, what matches depends on the program running
+            if (matches == Maybe::unknown) { ++i; break; }
+
+            if (not cases.back().guard) {
+                i = match->cases.size();
+                break;
+            }
+        }
+
+        // nothing matching is an error, and that's left to the interpreter. Nothing was moved out if it's empty
+        if (cases.empty()) return nullptr;
+
+        for (; i < match->cases.size(); ++i) cases.push_back(std::move(match->cases[i]));
+
+        const auto pruned = match->cases.size() - cases.size();
+        match->cases = std::move(cases);
+
+        if (pruned) lines.push_back(std::format("pruned {} case{} of a match on `{}`", pruned, pruned == 1 ? "" : "s", match->expr->stringify()));
+
+        return nullptr; // the match stays, with fewer cases
+    }
+
+    enum class Maybe { no, yes, unknown };
+
+    Maybe matchesLiteral(const expr::Match::Case::Pattern& pattern, const Value& value) {
+        // only objects are taken apart
+        if (std::holds_alternative<expr::Match::Case::Pattern::Structure>(pattern.pattern)) return Maybe::no;
+
+        const auto& single = get<expr::Match::Case::Pattern::Single>(pattern.pattern);
+
+        if (not accepts(single.type, value)) {
+            const auto t = single.type->text();
+            const bool other = type::isBuiltin(single.type) and not assignments.contains(single.type->ID)
+                and (t == "Int" or t == "Double" or t == "Bool" or t == "String");
+
+            return other ? Maybe::no : Maybe::unknown;
+        }
+
+        if (not single.value) return Maybe::yes;
+        if (not isLiteral(single.value)) return Maybe::unknown;
+
+        return literalValue(single.value) == value ? Maybe::yes : Maybe::no;
+    }
+
+
+    expr::ExprPtr simplify(auto *) { return nullptr; }
+
+
+
+    // whether calling the builtin on these can't fail
+    static bool foldable(const std::string_view name, const std::vector<Value>& values) {
+        const auto number = [] (const Value& v) { return std::holds_alternative<BigInt>(v) or std::holds_alternative<double>(v); };
+        const auto zero   = [] (const Value& v) { return std::holds_alternative<BigInt>(v) and get<BigInt>(v) == 0; };
+
+        if (values.size() == 1) {
+            const auto& v = values[0];
+
+            if (name == "neg") return number(v);
+            if (name == "not") return std::holds_alternative<bool>(v);
+            if (name == "len") return std::holds_alternative<std::string>(v);
+            if (name == "to_string") return true;
+            if (name == "to_int") return std::holds_alternative<BigInt>(v) or std::holds_alternative<bool>(v)
+                or (std::holds_alternative<double>(v) and std::abs(get<double>(v)) < 9e18);
+            if (name == "to_double") return number(v) or std::holds_alternative<bool>(v);
+
+            return false;
+        }
+
+        if (values.size() != 2) return false;
+
+        const auto& [a, b] = std::tie(values[0], values[1]);
+
+        if (name == "eq") return true;
+        if (name == "div") return number(a) and number(b) and not (std::holds_alternative<BigInt>(a) and zero(b));
+        if (name == "mod") return std::holds_alternative<BigInt>(a) and std::holds_alternative<BigInt>(b) and not zero(b);
+
+        for (const auto n : {"add", "sub", "mul", "pow", "gt", "geq", "leq", "lt"})
+            if (name == n) return number(a) and number(b);
+
+        return false;
+    }
+
+
+    expr::ExprPtr call_(const std::string_view name, const std::vector<Value>& values) {
+        if (not foldable(name, values)) return nullptr;
+
+        const auto builtin = Interpreter::builtinCall(name, values.size());
+        if (not builtin) return nullptr;
+
+        if (not interp) interp.emplace();
+
+        try { return literal(builtin(*interp, values.data())); }
+        catch (const std::exception&) { return nullptr; } // left to fail when it runs
+    }
+};
+
+
+
+// * inlining * //
+// a call to a small closure that's bound once at the top level, and never reassigned, runs its body right at the call site:
+// no looking the callee up, no named argument or variadic handling, no replaying the closure's environments.
+// The call node only gets marked (`Call::inlined`), the interpreter binds the arguments in a single frame
+// and runs the closure's own body, so the parameters keep their IDs: the frame shadows anything else with them
+struct Inliner {
+    static constexpr size_t max_nodes = 16; // in the body
+
+    Assignments assignments;
+    std::unordered_map<ssize_t, const expr::Closure*> inlinable;
+    size_t inlined{}; // call sites
+
+    std::vector<std::pair<std::string, ssize_t>> names; // of the inlinable closures, in order
+    std::unordered_map<ssize_t, size_t> sites;
+
+    // the call graph of the top level: every closure bound to a name or an operator there,
+    // and the ones its body may call through the names and operators it mentions
+    std::unordered_map<ssize_t, std::vector<const expr::Closure*>> bound;
+    std::unordered_map<std::string, std::vector<const expr::Closure*>> operators;
+    std::unordered_map<const expr::Closure*, std::vector<const expr::Closure*>> callees;
+
+
+    void operator()(std::vector<expr::ExprPtr>& exprs) {
+        assignments = assignmentsIn(exprs);
+        callGraph(exprs);
+
+        for (const auto& e : exprs) consider(e.get());
+
+        if (inlinable.empty()) return;
+
+        for (auto& e : exprs) walk(e, [this] (const expr::ExprPtr& e) { mark(e.get()); });
+    }
+
+
+    [[nodiscard]] std::vector<std::string> report() const {
+        std::vector<std::string> lines;
+
+        for (const auto& [name, ID] : names) {
+            if (const auto it = sites.find(ID); it != sites.end())
+                lines.push_back(std::format("inlined `{}` at {} call site{}", name, it->second, it->second == 1 ? "" : "s"));
+        }
+
+        return lines;
+    }
+
+
+    void callGraph(const std::vector<expr::ExprPtr>& exprs) {
+        for (const auto& e : exprs) {
+            if (const auto ass = dynamic_cast<const expr::Assignment*>(e.get()); ass and dynamic_cast<const expr::Name*>(ass->lhs.get())) {
+                if (const auto c = dynamic_cast<const expr::Closure*>(ass->rhs.get())) bound[ass->lhs->ID].push_back(c);
+            }
+            else if (const auto fix = dynamic_cast<const expr::Fix*>(e.get())) {
+                for (const auto& func : fix->funcs)
+                    if (const auto c = dynamic_cast<const expr::Closure*>(func.get())) operators[fix->name].push_back(c);
+            }
+        }
+
+        const auto add = [this] (const expr::Closure* from, const auto& table, const auto& key) {
+            if (const auto it = table.find(key); it != table.end()) {
+                auto& to = callees[from];
+                to.insert(to.end(), it->second.cbegin(), it->second.cend());
+            }
+        };
+
+        const auto edges = [this, &add] (const expr::Closure* c) {
+            auto body = c->body;
+            walk(body, [c, &add, this] (const expr::ExprPtr& e) {
+                if      (const auto name = dynamic_cast<const expr::Name*    >(e.get())) add(c, bound, name->ID);
+                else if (const auto op   = dynamic_cast<const expr::UnaryOp* >(e.get())) add(c, operators, op->op);
+                else if (const auto op   = dynamic_cast<const expr::BinOp*   >(e.get())) add(c, operators, op->op);
+                else if (const auto op   = dynamic_cast<const expr::PostOp*  >(e.get())) add(c, operators, op->op);
+                else if (const auto op   = dynamic_cast<const expr::CircumOp*>(e.get())) add(c, operators, op->op1);
+                else if (const auto op   = dynamic_cast<const expr::OpCall*  >(e.get())) add(c, operators, op->first);
+            });
+        };
+
+        for (const auto& [_, cs] : bound    ) for (const auto c : cs) edges(c);
+        for (const auto& [_, cs] : operators) for (const auto c : cs) edges(c);
+    }
+
+
+    // whether `c` can end up calling itself, directly or through any of the closures it calls.
+    // Closures that only get there as arguments (a parameter being called) aren't followed: they're not known until the call
+    bool recursive(const expr::Closure* c) const {
+        std::unordered_set<const expr::Closure*> seen;
+        std::vector<const expr::Closure*> todo{c};
+
+        while (not todo.empty()) {
+            const auto from = todo.back();
+            todo.pop_back();
+
+            const auto it = callees.find(from);
+            if (it == callees.end()) continue;
+
+            for (const auto to : it->second) {
+                if (to == c) return true;
+                if (seen.insert(to).second) todo.push_back(to);
+            }
+        }
+
+        return false;
+    }
+
+
+    // `name = (params) => body;` at the top level
+    void consider(const expr::Expr *e) {
+        const auto ass = dynamic_cast<const expr::Assignment*>(e);
+        if (not ass or not dynamic_cast<const expr::Name*>(ass->lhs.get())) return;
+
+        // a type on the name can change the closure's type when it's assigned
+        if (not type::shouldReassign(ass->type) or assignments[ass->lhs->ID] != 1) return;
+
+        const auto c = dynamic_cast<const expr::Closure*>(ass->rhs.get());
+        if (c and qualifies(*c)) {
+            inlinable[ass->lhs->ID] = c;
+            names.emplace_back(ass->lhs->stringify(), ass->lhs->ID);
+        }
+    }
+
+
+    // types that don't need the interpreter to mean the same thing everywhere: none, or a builtin nobody rebinds
+    bool plainType(const type::TypePtr& t) {
+        if (type::shouldReassign(t)) return true;
+
+        return type::isBuiltin(t) and not type::isSyntax(t) and not assignments.contains(t->ID);
+    }
+
+
+    bool qualifies(const expr::Closure& c) {
+        constexpr auto none = expr::Closure::Dependencies::none;
+
+        const auto& deps = c.dependencies();
+        if (deps.ret != none or std::ranges::any_of(deps.params, [] (const size_t p) { return p != none; })) return false;
+
+        if (not std::ranges::all_of(c.type.params, [this] (const auto& t) { return plainType(t); })) return false;
+        if (not plainType(c.type.ret)) return false;
+
+        size_t nodes{};
+        bool simple = true;
+
+        // not recursive, not even through other functions
+        if (recursive(&c)) return false;
+
+        // only expressions that don't bind names, capture, or jump
+        auto body = c.body;
+        walk(body, [&nodes, &simple] (const expr::ExprPtr& e) {
+            ++nodes;
+
+            simple = simple and std::visit([] <typename T> (T *) {
+                return std::same_as<T, expr::Num> or std::same_as<T, expr::Bool> or std::same_as<T, expr::String>
+                    or std::same_as<T, expr::Name> or std::same_as<T, expr::List> or std::same_as<T, expr::Map>
+                    or std::same_as<T, expr::Access> or std::same_as<T, expr::SpaceAccess> or std::same_as<T, expr::Grouping>
+                    or std::same_as<T, expr::UnaryOp> or std::same_as<T, expr::BinOp> or std::same_as<T, expr::PostOp>
+                    or std::same_as<T, expr::CircumOp> or std::same_as<T, expr::OpCall> or std::same_as<T, expr::Call>;
+            }, e->variant());
+        });
+
+        return simple and nodes <= max_nodes;
+    }
+
+
+    void mark(expr::Expr *e) {
+        const auto call = dynamic_cast<expr::Call*>(e);
+        if (not call or not call->named_args.empty() or not dynamic_cast<const expr::Name*>(call->func.get())) return;
+
+        const auto it = inlinable.find(call->func->ID);
+        if (it == inlinable.end() or call->args.size() != it->second->params.size()) return;
+
+        // curried calls, and packs whose length isn't known yet, go the normal way
+        if (std::ranges::any_of(call->args, [] (const auto& arg) { return dynamic_cast<const expr::Expansion*>(arg.get()); }))
+            return;
+
+        call->inlined = it->second;
+        ++inlined;
+        ++sites[it->first];
+    }
+};
+
+
+
+// runs every pass on an analysed program, if optimizing is on.
+// Folding goes first so what's left to inline is as small as it gets
+template <typename Interpreter = interp::Visitor>
+void optimize(std::vector<expr::ExprPtr>& exprs) {
+    if (optimization() < 1) return;
+
+    ConstantFolder<Interpreter> folder;
+    folder(exprs);
+
+    Inliner inliner;
+    inliner(exprs);
+
+    if (not optimizationReport()) return;
+
+    for (const auto& line : folder.report()) std::println(std::clog, "[opt] {}", line);
+    for (const auto& line : inliner.report()) std::println(std::clog, "[opt] {}", line);
+}
+
+
+} // namespace analysis
+} // namespace pie
@@ -0,0 +1,194 @@
+// runs every Bench/*.pie a few times and prints the results as JSON
+// usage: run_bench [runs = 5] [only workloads whose name contains this]
+//
+// every workload runs in its own process, so the peak RSS reported is that workload's alone
+// and one workload crashing doesn't take the others with it
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "../Utils/CLI.hxx"
+
+
+// * allocation counting * //
+// GCC can't tell these replace the global operators, and warns about malloc/free pairing with new/delete
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static std::atomic<size_t> allocations;
+
+void* operator new(const size_t n) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* const p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const p) noexcept { std::free(p); }
+void operator delete(void* const p, size_t) noexcept { std::free(p); }
+
+
+
+struct Result {
+    std::string name;
+    std::vector<double> times; // ms
+    size_t allocations{};
+    long peak_rss_kb{};
+    std::string error;
+};
+
+
+static std::string escape(const std::string_view s) {
+    std::string escaped;
+    for (const char c : s) {
+        if (c == '"' or c == '\\') escaped += '\\';
+        if (c == '\n') escaped += "\\n";
+        else if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+    }
+
+    return escaped;
+}
+
+
+// runs in the child. Reports back through `fd` as text: `ok allocations time...` or `error message`
+[[noreturn]] static void measure(const std::filesystem::path& program, const size_t runs, const int fd) {
+    FILE* const report = fdopen(fd, "w");
+
+    // the programs' own output is not what's being measured
+    if (const int null = open("/dev/null", O_WRONLY); null >= 0) dup2(null, STDOUT_FILENO);
+
+    std::vector<double> times;
+    size_t allocated{};
+
+    try {
+        for (size_t i{}; i < runs; ++i) {
+            pie::modules::table().clear(); // imports are part of the work
+
+            const size_t before = allocations.load();
+            const auto start = std::chrono::steady_clock::now();
+
+            pie::cli::runFile(program, false, false, false, true);
+
+            const auto end = std::chrono::steady_clock::now();
+            allocated = allocations.load() - before;
+
+            times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(report, "error %s", e.what());
+        std::fclose(report);
+        std::_Exit(1);
+    }
+
+    std::fprintf(report, "ok %zu", allocated);
+    for (const double t : times) std::fprintf(report, " %f", t);
+
+    std::fclose(report);
+    std::_Exit(0);
+}
+
+
+static Result run(const std::filesystem::path& program, const size_t runs) {
+    Result result{.name = program.stem().string(), .times = {}, .allocations = {}, .peak_rss_kb = {}, .error = {}};
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        result.error = "pipe failed";
+        return result;
+    }
+
+    std::fflush(nullptr);
+    const pid_t pid = fork();
+
+    if (pid == 0) {
+        close(fds[0]);
+        measure(program, runs, fds[1]);
+    }
+
+    close(fds[1]);
+
+    std::string report;
+    char buffer[4096];
+    for (ssize_t n; (n = read(fds[0], buffer, sizeof buffer)) > 0;) report.append(buffer, static_cast<size_t>(n));
+    close(fds[0]);
+
+    int status{};
+    rusage usage{};
+    wait4(pid, &status, 0, &usage);
+    result.peak_rss_kb = usage.ru_maxrss; // kilobytes on Linux
+
+
+    if (report.starts_with("ok ")) {
+        const char* p = report.c_str() + 3;
+        char* end;
+
+        result.allocations = std::strtoull(p, &end, 10);
+        for (p = end; *p; p = end) {
+            const double t = std::strtod(p, &end);
+            if (end == p) break;
+            result.times.push_back(t);
+        }
+    }
+    else if (report.starts_with("error ")) result.error = report.substr(6);
+    else result.error = "crashed (status " + std::to_string(status) + ')';
+
+    return result;
+}
+
+
+int main(int argc, char* argv[]) {
+    const size_t runs = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+    const std::string_view filter = argc > 2 ? argv[2] : "";
+
+    const std::filesystem::path dir = std::filesystem::exists("Bench") ? "Bench" : ".";
+
+    std::vector<std::filesystem::path> programs;
+    for (const auto& entry : std::filesystem::directory_iterator{dir})
+        if (entry.path().extension() == ".pie" and entry.path().stem().string().contains(filter))
+            programs.push_back(entry.path());
+
+    std::ranges::sort(programs);
+
+
+    std::printf("{\n  \"runs\": %zu,\n  \"workloads\": [", runs);
+
+    for (bool first = true; const auto& program : programs) {
+        auto result = run(program, runs);
+
+        std::printf("%s\n    {\"name\": \"%s\"", first ? "" : ",", escape(result.name).c_str());
+        first = false;
+
+        if (not result.error.empty()) {
+            std::printf(", \"error\": \"%s\"}", escape(result.error).c_str());
+            continue;
+        }
+
+        std::ranges::sort(result.times);
+        const double median = result.times.size() % 2
+            ? result.times[result.times.size() / 2]
+            : (result.times[result.times.size() / 2 - 1] + result.times[result.times.size() / 2]) / 2;
+
+        std::printf(
+            ", \"median_ms\": %.3f, \"min_ms\": %.3f, \"max_ms\": %.3f, \"allocations\": %zu, \"peak_rss_kb\": %ld}",
+            median, result.times.front(), result.times.back(), result.allocations, result.peak_rss_kb
+        );
+
+        std::fflush(stdout);
+    }
+
+    std::printf("\n  ]\n}\n");
+}
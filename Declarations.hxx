@@ -67,6 +67,7 @@ using ExprPtr = std::shared_ptr<Expr>;
 
 struct Expr {
     ssize_t ID{-1};
+    ssize_t space{-1}; // slot of the namespace `ID` is a member of, if it is one. Set by the analysis
 
     virtual ~Expr() = default;
     virtual std::string stringify(const size_t indent = 0) const = 0;
@@ -10,6 +10,7 @@
 #include <ranges>
 #include <variant>
 #include <optional>
+#include <limits>
 #include <memory>
 
 #include "../Utils/utils.hxx"
@@ -28,11 +29,14 @@ inline namespace value {
     struct Members;
     using Object      = std::pair<type::TypePtr, std::shared_ptr<Members>>;
 
+    struct Shape;
+    using ShapePtr    = std::shared_ptr<const Shape>;
+
     struct SpaceRef {
         std::string name;
-        std::string space = "";
+        ssize_t space = -1; // slot of the namespace the variable lives in, if it's a reference to one
 
-        bool isRef() const { return not space.empty(); }
+        bool isRef() const { return space >= 0; }
     };
 
     using Environment = std::unordered_map<
@@ -423,10 +427,12 @@ struct Match : Expr {
                 StringID name;
                 type::TypePtr type;
                 ExprPtr value;
+
+                mutable value::ValuePtr constant{}; // `value` evaluated once, when it's an unbound literal
             };
 
             using Patterns = std::vector<std::unique_ptr<Pattern>>;
-            struct Structure { StringID type_name; Patterns patterns; };
+            struct Structure { StringID type_name; Patterns patterns; ssize_t space = -1; /* of `type_name`, same as `Expr::space` */ };
 
 
             std::variant<
@@ -450,6 +456,13 @@ struct Match : Expr {
     ExprPtr expr;
     std::vector<Case> cases;
 
+    // built on first evaluation: for each alternative of value::Value, the indices of the cases that could match it
+    mutable std::vector<std::vector<size_t>> dispatch;
+    // and for every Int and String literal a case is written with, the cases that could match that very value.
+    // other values of those kinds go through `dispatch`, which leaves the literal cases out
+    mutable std::unordered_map<BigInt     , std::vector<size_t>> int_cases;
+    mutable std::unordered_map<std::string, std::vector<size_t>> string_cases;
+
     Match(ExprPtr e, std::vector<Case> cs) noexcept
     : expr{std::move(e)}, cases{std::move(cs)}
     {}
@@ -495,7 +508,7 @@ private:
             return pat.name.name + type + def;
         }
 
-        const auto& [name, patterns] = get<Case::Pattern::Structure>(pattern.pattern);
+        const auto& [name, patterns, _] = get<Case::Pattern::Structure>(pattern.pattern);
 
         std::string s = name.name + '(';
 
@@ -613,6 +626,10 @@ struct Access : Expr {
     ExprPtr var;
     std::string name;
 
+    // inline cache: the last object shape seen at this access and the slot `name` lived in
+    mutable value::ShapePtr cached_shape;
+    mutable size_t cached_slot{};
+
     Access(ExprPtr v, std::string n) noexcept
     : var{std::move(v)}, name{std::move(n)}
     {}
@@ -659,6 +676,7 @@ struct Cascade : Expr {
 struct Namespace : Expr {
     std::string name;
     std::vector<ExprPtr> space;
+    ssize_t slot = -1; // filled in by the analysis
 
 
     explicit Namespace(std::string n, std::vector<ExprPtr> exprs) noexcept
@@ -689,6 +707,7 @@ struct Use : Expr {
     // last name is not a space
     std::vector<std::string> spaces;
     StringID name;
+    ssize_t slot = -1; // of the namespace. Filled in by the analysis
 
     explicit Use(bool g, std::vector<std::string> ns, std::string n) noexcept
     : global{g}, spaces{std::move(ns)}, name{std::move(n)} {}
@@ -716,9 +735,8 @@ struct Use : Expr {
 struct UseSpace : Expr {
     bool global;
     std::vector<std::string> spaces;
-    ssize_t last_item_id;
-
-    std::vector<std::pair<std::string, std::string>> children; // children full name against short name
+    ssize_t last_item_id = -1;
+    ssize_t slot = -1; // of the namespace. Filled in by the analysis
 
 
     explicit UseSpace(bool g, std::vector<std::string> ns) noexcept
@@ -753,6 +771,10 @@ struct UseSpace : Expr {
 struct Import : Expr {
     std::filesystem::path path;
 
+    // parsed and analysed the first time the import is evaluated
+    struct Module { std::vector<ExprPtr> exprs; Operators ops; };
+    mutable std::shared_ptr<const Module> module;
+
     explicit Import(std::filesystem::path p) noexcept
     : path{std::move(p)} {}
 
@@ -776,6 +798,7 @@ struct SpaceAccess : Expr {
     bool global;
     std::vector<std::string> spaces;
     StringID name;
+    ssize_t slot = -1; // of the namespace. Filled in by the analysis
 
 
     SpaceAccess(bool g, std::vector<std::string> s, std::string n) noexcept
@@ -969,6 +992,9 @@ struct Call : Expr {
     std::unordered_map<std::string, ExprPtr> named_args;
     std::vector<ExprPtr> args;
 
+    const struct Closure* inlined = nullptr; // set by the inliner (Analysis/Optimizer.hxx): the body runs right here
+    bool positional = false; // set by the analysis: no named arguments and no packs to expand, so argument i goes to parameter i
+
 
     Call(ExprPtr function, std::unordered_map<std::string, ExprPtr> named = {}, std::vector<ExprPtr> pos = {})
     : func{std::move(function)}, named_args{std::move(named)}, args{std::move(pos)} { }
@@ -1030,6 +1056,32 @@ struct Closure : Expr {
     // whether it's a member function or not
     mutable std::optional<Object> self{};
 
+    // the arguments a partial application already bound, by parameter ID. A call puts them in the frame along with its own
+    std::vector<std::pair<Environment::key_type, Environment::mapped_type>> bound{};
+
+    // for every parameter type, the index of the first parameter it mentions (`none` if it doesn't mention any). Same for the return type.
+    // types that depend on earlier parameters can only be checked once those are bound,
+    // so this decides which types get evaluated when. Worked out once, instead of searching the types on every call
+    struct Dependencies {
+        static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> params;
+        size_t ret = none;
+
+        bool plain = false; // no variadic parameter and no type depending on a parameter: the arguments can be bound as they come
+    };
+
+    mutable std::optional<Dependencies> deps{};
+
+    // for bodies that only pass the parameters, in order, to a builtin: `(a, b) => __builtin_add(a, b)`.
+    // the interpreter calls the builtin on the arguments right away for those. Worked out on first use
+    struct Direct {
+        value::Value (*call)(interp::Visitor&, const value::Value* args) = nullptr; // null if the body is anything else
+        std::string builtin;
+    };
+
+    mutable std::optional<Direct> direct{};
+
     Closure(std::vector<StringID> ps, ExprPtr b, type::FuncType t) noexcept
     : params{std::move(ps)}, body{std::move(b)}, type{std::move(t)} { }
 
@@ -1052,6 +1104,43 @@ struct Closure : Expr {
     void captureThis(const Object& obj) const { self = obj; }
 
 
+    bool isBound(const ssize_t ID) const {
+        return std::ranges::any_of(bound, [ID] (const auto& b) { return static_cast<ssize_t>(b.first) == ID; });
+    }
+
+
+    // the analysis fills this in, anything it didn't see gets it on first use
+    const Dependencies& dependencies() const {
+        if (deps) return *deps;
+
+        // by ID, unless the analysis never saw the closure
+        const auto first = [this] (const type::TypePtr& type) {
+            for (size_t i{}; i < params.size(); ++i) {
+                const auto ID = params[i].ID;
+                if (ID >= 0 ? type->involvesID([ID] (const ssize_t id) { return id == ID; }) : type->involvesName(params[i].name)) return i;
+            }
+
+            return Dependencies::none;
+        };
+
+        Dependencies d;
+        for (const auto& type : this->type.params) d.params.push_back(first(type));
+        d.ret = first(this->type.ret);
+
+        // types can mention parameters that were bound by a partial application too
+        const auto mentions_bound = [this] (const type::TypePtr& type) {
+            return not bound.empty() and type->involvesID([this] (const ssize_t ID) { return isBound(ID); });
+        };
+
+        d.plain = d.ret == Dependencies::none
+            and std::ranges::all_of(d.params, [] (const size_t p) { return p == Dependencies::none; })
+            and std::ranges::none_of(this->type.params, [] (const auto& t) { return type::isVariadic(t); })
+            and std::ranges::none_of(this->type.params, mentions_bound) and not mentions_bound(this->type.ret);
+
+        return deps.emplace(std::move(d));
+    }
+
+
     std::string stringify(const size_t indent = 0) const override {
         std::string s = "(";
 
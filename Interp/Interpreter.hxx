@@ -24,10 +24,15 @@
 #include "../Utils/utils.hxx"
 #include "../Utils/Exceptions.hxx"
 #include "../Utils/ConstexprLookup.hxx"
+#include "../Utils/MappedFile.hxx"
+#include "../Utils/Profiler.hxx"
+#include "../Utils/Counters.hxx"
 #include "../Lex/Lexer.hxx"
 #include "../Expr/Expr.hxx"
 #include "../Type/Type.hxx"
 #include "../Parser/Parser.hxx"
+#include "../Analysis/LexicalScoping.hxx"
+#include "../Analysis/Optimizer.hxx"
 
 #include "Value.hxx"
 
@@ -48,19 +53,12 @@ struct Visitor {
     // Environment env;
     Operators ops;
 
-    std::unordered_map<
-        std::string,
-        std::unordered_map<
-            size_t,
-            std::tuple<
-                value::SpaceRef,
-                value::ValuePtr,
-                type::TypePtr
-            >
-        >
-    > namespaces;
+    // indexed by the slots the analysis gives every namespace
+    std::vector<Environment> namespaces;
 
-    std::vector<std::string> current_ns;
+    // `use space`s, as (frame in `env`, namespace slot), so a space that uses another can make its members its own.
+    // ordered by frame, since frames only come and go at the top
+    std::vector<std::pair<size_t, ssize_t>> views;
 
     // _this_ (or self) context
     std::vector<Object> selves{};
@@ -75,6 +73,9 @@ struct Visitor {
     std::unordered_map<std::string, std::vector<size_t>> co_map;
 
 
+    type::TypePtr line_reader; // class of the iterator objects `__builtin_read_lines` makes, made on first use
+
+
 
 
     Visitor(Operators ops = {}) noexcept : env(1), ops{std::move(ops)} { }
@@ -94,7 +95,20 @@ struct Visitor {
     }
 
 
+    // -count mode tallies
+    template <typename T>
+    static void count(const T*) { if (const auto& c = util::counters(); c) [[unlikely]] c->node<T>(); }
+
+    // every value the interpreter puts on the heap goes through here
+    template <typename... Args>
+    static value::ValuePtr makeValue(Args&&... args) {
+        if (const auto& c = util::counters(); c) [[unlikely]] ++c->value_allocations;
+        return std::make_shared<Value>(std::forward<Args>(args)...);
+    }
+
+
     Value operator()(const expr::Num *n) {
+        count(n);
         if (const auto& var = getVar(n->ID); var) return var->first;
 
 
@@ -105,6 +119,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Bool *b) {
+        count(b);
         if (const auto& var = getVar(b->ID); var) return var->first;
 
         return b->boolean;
@@ -112,6 +127,7 @@ struct Visitor {
 
 
     Value operator()(const expr::String *s) {
+        count(s);
         if (const auto& var = getVar(s->ID); var) return var->first;
 
         return s->str;
@@ -122,9 +138,7 @@ struct Visitor {
         if (selves.empty()) return {};
 
         for (const auto& self : std::views::reverse(selves)) {
-            for (const auto& [member, _, value] : self.second->members) {
-                if (member.name == name) return *value;
-            }
+            if (const auto slot = self.second->slot(name)) return *get<ValuePtr>(self.second->members[*slot]);
         }
 
         return {};
@@ -135,11 +149,9 @@ struct Visitor {
         if (selves.empty()) util::error();
 
         for (const auto& self : std::views::reverse(selves)){
-            for (auto& [member, _, value] : self.second->members) {
-                if (member.name == name) {
-                    *value = val;
-                    return;
-                }
+            if (const auto slot = self.second->slot(name)) {
+                *get<ValuePtr>(self.second->members[*slot]) = std::move(val);
+                return;
             }
         }
 
@@ -147,31 +159,24 @@ struct Visitor {
     }
 
     Value fetchRef(const expr::Name *n) {
-        for (const auto& [e, _] : std::views::reverse(env)) {
-            if (e.contains(n->ID)) {
-                const auto& [named_ref, value_ptr, type_ptr] = e.at(n->ID);
-                const auto& [_, space] = named_ref;
-
-                if (not namespaces.contains(space) or not namespaces[space].contains(n->ID)) 
-                    util::error();
-
-                return *get<value::ValuePtr>(namespaces[space][n->ID]);
-            }
-        }
+        const auto space = refSpace(n->ID, n->space);
 
+        if (not spaceAt(space).contains(n->ID))
+            util::error();
 
-        util::error();
+        return *get<value::ValuePtr>(namespaces[space][n->ID]);
     }
 
 
     Value operator()(const expr::Name *n) {
+        count(n);
         // what should builtins evaluate to?
         // If I return the string back, then expressions like `"__builtin_neg"(1)` are valid now :))))
         // interesting!
         // how about a special value?
 
-        if (const auto& var = getVar(n->ID); var) {
-            if (isRef(n->ID)) return fetchRef(n);
+        if (const auto& var = getVar(n->ID, n->space); var) {
+            if (isRef(n->ID, n->space)) return fetchRef(n);
 
             return var->first;
         }
@@ -202,6 +207,7 @@ struct Visitor {
 
 
     Value operator()(const expr::List* list) {
+        count(list);
         if (const auto& var = getVar(list->ID); var) return var->first;
 
         std::vector<Value> values;
@@ -215,6 +221,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Map* map) {
+        count(map);
         MapValue map_value{std::make_shared<Items>()};
 
         for (auto [key, expr] : map->items) {
@@ -233,6 +240,8 @@ struct Visitor {
 
 
     value::Value typeCheck(Value value, const type::TypePtr& type, std::string err_msg = "", const std::source_location& location = std::source_location::current()) {
+        if (const auto& c = util::counters(); c) [[unlikely]] ++c->type_checks;
+
         const auto value_type = typeOf(value);
         if (err_msg.empty()) err_msg = "Expected type '" + type->text() + "', got type '" + value_type->text() + '\'';
 
@@ -240,18 +249,21 @@ struct Visitor {
 
         if (const auto cls = type::isClass(type)) {
             auto obj = get<value::Object>(value);
-            obj.second = std::make_shared<Members>(obj.second->members);
+            const auto& from = *obj.second;
+            const auto& blueprint = *cls->cls->blueprint;
 
-            std::erase_if(
-                obj.second->members,
-                [cls] (const auto& member) {
-                    const auto& [name, _, __] = member;
+            // only the class's members are kept, laid out in the class's order.
+            // so the narrowed object can share the blueprint's shape instead of getting one of its own
+            auto narrowed = std::make_shared<Members>();
+            narrowed->members.reserve(blueprint.fields.size());
 
-                    return std::ranges::find_if(cls->cls->blueprint->fields, [&name](const auto& field) {
-                        return get<expr::Name>(field).name == name.name;
-                    }) == cls->cls->blueprint->fields.cend();
-                }
-            );
+            for (const auto& field : blueprint.fields)
+                if (const auto slot = from.slot(get<expr::Name>(field).name))
+                    narrowed->members.push_back(from.members[*slot]);
+
+            narrowed->shape = narrowed->members.size() == blueprint.fields.size() ? blueprint.shape() : Shape::of(narrowed->members);
+
+            obj.second = std::move(narrowed);
             obj.first = type;
 
             return obj;
@@ -261,356 +273,195 @@ struct Visitor {
     }
 
 
-    Value operator()(const expr::UnaryFold *fold) {
-        if (const auto& var = getVar(fold->ID); var) return var->first;
-
-        Value pack = std::visit(*this, fold->pack->variant());
-
-        if (not std::holds_alternative<PackList>(pack)) util::error("Folding over a non-pack: " + stringify(pack));
-
-        auto& packlist = get<PackList>(pack);
-
-        if (packlist->values.empty()) util::error("Folding over an empty pack: " + fold->stringify());
-        if (packlist->values.size() == 1) return packlist->values[0];
-
-
-        Value ret = fold->left_to_right ? packlist->values.front() : packlist->values.back(); // [packlist->values.size() - 2];
-        const auto values = fold->left_to_right?
-            packlist->values |                       std::views::drop(1) | std::views::as_rvalue | std::ranges::to<std::vector<Value>>():
-            packlist->values | std::views::reverse | std::views::drop(1) | std::views::as_rvalue | std::ranges::to<std::vector<Value>>();
-
-        const auto& op = ops.at(fold->op);
+    // folds `ret` with `size` more values through the infix operator `name`, `at(k)` being the k-th of them.
+    // the values are read from wherever they are, and the whole fold runs in a single frame:
+    // the 2 parameters are rebound in place instead of a fresh scope and 2 fresh values per element
+    template <std::invocable<size_t> At>
+    Value fold(const std::string& name, Value ret, const bool left_to_right, const size_t size, At at) {
+        const auto& op = ops.at(name);
 
         // can't have any syntax type since the pack consists of values, not expressions..
         // unless...!
         // TODO: allow for folding over syntax...maybe
         checkNoSyntaxType(op->funcs);
 
-        expr::Closure* func;
-
-        const size_t  first_idx = 1 - fold->left_to_right;
-        const size_t second_idx =     fold->left_to_right;
+        const size_t  first_idx = 1 - left_to_right;
+        const size_t second_idx =     left_to_right;
 
         // no overload resolution required
-        if (op->funcs.size() == 1) {
+        const bool single = op->funcs.size() == 1;
+        expr::Closure* func{};
+
+        if (single) {
             func = dynamic_cast<expr::Closure*>(op->funcs[0].get());
 
-            func->type.ret =                validateType(std::move(func)->type.ret               );
+            func->type.ret                = validateType(std::move(func)->type.ret               );
             func->type.params[ first_idx] = validateType(std::move(func)->type.params[ first_idx]);
             func->type.params[second_idx] = validateType(std::move(func)->type.params[second_idx]);
+        }
 
 
-            for (const auto& value : values) {
+        ScopeGuard sg{this};
+        const size_t frame = env.size() - 1; // by index, the body can grow `env`
+
+        // reuses the value the parameter had in the last step, unless something (a closure) held on to it
+        const auto bind = [this, frame] (const expr::StringID& param, Value value, const type::TypePtr& type) {
+            auto& e = env[frame].first;
+
+            if (const auto it = e.find(param.ID); it != e.end() and get<ValuePtr>(it->second).use_count() == 1) {
+                *get<ValuePtr>(it->second) = std::move(value);
+                get<type::TypePtr>(it->second) = type;
+            }
+            else e[param.ID] = {{param.name}, makeValue(std::move(value)), type};
+        };
 
+
+        for (size_t k{}; k < size; ++k) {
+            const Value& value = at(k);
+
+            if (single) {
                 typeCheck(ret, func->type.params[first_idx],
-                    "Type mis-match in Fold expressions with Infix operator '" + fold->op + 
-                    "', parameter '" + func->params[0].name +
-                    "' expected: " + func->type.params[0]->text() +
+                    "Type mis-match in Fold expressions with Infix operator '" + name +
+                    "', parameter '" + func->params[first_idx].name +
+                    "' expected: " + func->type.params[first_idx]->text() +
                     ", got: " + stringify(ret) + " which is " + typeOf(ret)->text()
                 );
 
-
-                typeCheck(value, func->type.params[second_idx], 
-                    "Type mis-match in Fold expressions with Infix operator '" + fold->op + 
-                    "', parameter '" + func->params[1].name +
-                    "' expected: " + func->type.params[1]->text() +
+                typeCheck(value, func->type.params[second_idx],
+                    "Type mis-match in Fold expressions with Infix operator '" + name +
+                    "', parameter '" + func->params[second_idx].name +
+                    "' expected: " + func->type.params[second_idx]->text() +
                     ", got: " + stringify(value) + " which is " + typeOf(value)->text()
                 );
-
-                Environment args_env;
-                args_env[func->params[ first_idx].ID] = {{func->params[ first_idx].name}, std::make_shared<Value>(ret  ), func->type.params[ first_idx]};
-                args_env[func->params[second_idx].ID] = {{func->params[second_idx].name}, std::make_shared<Value>(value), func->type.params[second_idx]};
-
-
-                ScopeGuard sg{this, args_env};
-
-                ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
             }
-        }
-        else { // fuck me
-            checkNoSyntaxType(op->funcs);
-
-            for (const auto& value : values) {
-
+            else { // fuck me
                 // if the overload set is resolved, no need to type check again...i think!!!
-                func = resolveOverloadSet(
-                    op->OpName(), op->funcs,
-                    {ret, value}
-                    // {validateType(typeOf(ret)), validateType(typeOf(value))},
-                );
+                func = resolveOverloadSet(op->OpName(), op->funcs, {ret, value});
+
                 func->type.ret                = validateType(std::move(func)->type.ret               );
                 func->type.params[ first_idx] = validateType(std::move(func)->type.params[ first_idx]);
                 func->type.params[second_idx] = validateType(std::move(func)->type.params[second_idx]);
+            }
 
+            if (const auto& direct = directCall(*func); direct.call) {
+                Value args[2];
+                args[ first_idx] = std::move(ret);
+                args[second_idx] = value;
 
-                Environment args_env;
-                args_env[func->params[1 - fold->left_to_right].ID] =
-                    {{func->params[1 - fold->left_to_right].name}, std::make_shared<Value>(ret)  , func->type.params[1 - fold->left_to_right]};
-
-                args_env[func->params[    fold->left_to_right].ID] =
-                    {{func->params[    fold->left_to_right].name}, std::make_shared<Value>(value), func->type.params[    fold->left_to_right]};
+                ret = callDirect(*func, direct, args);
+                continue;
+            }
 
+            // whatever the last step left behind (its own variables, another overload's parameters) goes
+            if (env[frame].first.size() > 2) env[frame].first.clear();
 
-                ScopeGuard sg{this, args_env};
+            bind(func->params[ first_idx], std::move(ret), func->type.params[ first_idx]);
+            bind(func->params[second_idx], value         , func->type.params[second_idx]);
 
-                ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
-            }
+            ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
         }
 
         return ret;
     }
 
 
-    Value operator()(const expr::SeparatedUnaryFold *fold) {
+    Value operator()(const expr::UnaryFold *fold) {
+        count(fold);
         if (const auto& var = getVar(fold->ID); var) return var->first;
 
+        Value pack = std::visit(*this, fold->pack->variant());
 
-        Value lhs = std::visit(*this, fold->lhs->variant());
-        Value rhs = std::visit(*this, fold->rhs->variant());
-
-
-        const auto l_pack = std::holds_alternative<PackList>(lhs), l2r = l_pack;
-        const auto r_pack = std::holds_alternative<PackList>(rhs);
-
-
-        if (l_pack == r_pack) {
-            std::string err = l_pack ? "Folding over 2 packs: '" : "Folding over non-packs: '";
-            util::error(err + fold->lhs->stringify() + "' and '" + fold->rhs->stringify() + '\'');
-        }
-
-        Value pack = l_pack? std::move(lhs) : std::move(rhs);
-        Value sep  = r_pack? std::move(lhs) : std::move(rhs);
-
-        auto& packlist = get<PackList>(pack);
-
-        if (packlist->values.empty()) util::error("Folding over an empty pack: " + fold->stringify());
-        if (packlist->values.size() == 1) return packlist->values[0];
-
-
-        Value ret;
-        std::vector<Value> values;
-        values.reserve(packlist->values.size() * 2 - 1);
-        if (l2r) {
-            ret = std::move(packlist)->values[0];
-
-            for (auto& value : packlist->values | std::views::drop(1)) {
-                values.push_back(sep);
-                values.push_back(std::move(value));
-            }
-        }
-        else {
-            ret = sep;
-
-            const auto len = packlist->values.size();
-
-            values.push_back(std::move(packlist)->values[len - 1]);
-            values.push_back(std::move(packlist)->values[len - 2]);
-
-            for (auto& value : packlist->values | std::views::reverse | std::views::drop(2)) {
-                values.push_back(sep);
-                values.push_back(std::move(value));
-            }
-        }
-
+        if (not std::holds_alternative<PackList>(pack)) util::error("Folding over a non-pack: " + stringify(pack));
 
+        const auto& values = get<PackList>(pack)->values;
 
-        const auto& op = ops.at(fold->op);
+        if (values.empty()) util::error("Folding over an empty pack: " + fold->stringify());
+        if (values.size() == 1) return values[0];
 
-        // can't have any syntax type since the pack consists of values, not expressions..
-        // unless...!
-        // TODO: allow for folding over syntax...maybe
-        checkNoSyntaxType(op->funcs);
 
-        expr::Closure* func;
-
-        const size_t  first_idx = 1 - l2r;
-        const size_t second_idx =     l2r;
-
-        // no overload resolution required
-        if (op->funcs.size() == 1) {
-            func = dynamic_cast<expr::Closure*>(op->funcs[0].get());
-            func->type.ret                = validateType(std::move(func)->type.ret               );
-            func->type.params[ first_idx] = validateType(std::move(func)->type.params[ first_idx]);
-            func->type.params[second_idx] = validateType(std::move(func)->type.params[second_idx]);
+        const size_t n = values.size();
 
+        if (fold->left_to_right)
+            return this->fold(fold->op, values.front(), true , n - 1, [&] (const size_t k) -> const Value& { return values[k + 1]; });
 
+        return this->fold(fold->op, values.back(), false, n - 1, [&] (const size_t k) -> const Value& { return values[n - 2 - k]; });
+    }
 
-            for (const auto& value : values) {
 
-                typeCheck(ret, func->type.params[first_idx],
-                    "Type mis-match in Fold expressions with Infix operator '" + fold->op + 
-                    "', parameter '" + func->params[0].name +
-                    "' expected: " + func->type.params[0]->text() +
-                    ", got: " + stringify(ret) + " which is " + typeOf(ret)->text()
-                );
+    Value operator()(const expr::SeparatedUnaryFold *fold) {
+        count(fold);
+        if (const auto& var = getVar(fold->ID); var) return var->first;
 
-                typeCheck(ret, func->type.params[second_idx],
-                    "Type mis-match in Fold expressions with Infix operator '" + fold->op + 
-                    "', parameter '" + func->params[1].name +
-                    "' expected: " + func->type.params[1]->text() +
-                    ", got: " + stringify(ret) + " which is " + typeOf(ret)->text()
-                );
 
+        Value lhs = std::visit(*this, fold->lhs->variant());
+        Value rhs = std::visit(*this, fold->rhs->variant());
 
-                Environment args_env;
-                args_env[func->params[ first_idx].ID] = {{func->params[ first_idx].name}, std::make_shared<Value>(ret)  , func->type.params[ first_idx]};
-                args_env[func->params[second_idx].ID] = {{func->params[second_idx].name}, std::make_shared<Value>(value), func->type.params[second_idx]};
 
+        const auto l_pack = std::holds_alternative<PackList>(lhs), l2r = l_pack;
+        const auto r_pack = std::holds_alternative<PackList>(rhs);
 
-                ScopeGuard sg{this, args_env};
 
-                ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
-            }
+        if (l_pack == r_pack) {
+            std::string err = l_pack ? "Folding over 2 packs: '" : "Folding over non-packs: '";
+            util::error(err + fold->lhs->stringify() + "' and '" + fold->rhs->stringify() + '\'');
         }
-        else { // fuck me
-            checkNoSyntaxType(op->funcs);
-
-            for (const auto& value : values) {
 
-                // auto type1 = validateType(typeOf(ret  ));
-                // auto type2 = validateType(typeOf(value));
+        const Value pack = l_pack? std::move(lhs) : std::move(rhs);
+        const Value sep  = r_pack? std::move(lhs) : std::move(rhs);
 
-                func = resolveOverloadSet(op->OpName(), op->funcs, {ret, value});
-                // I think these lines are needed. Have to check 
-                func->type.ret                = validateType(std::move(func)->type.ret             );
-                func->type.params[ first_idx] = validateType(std::move(func)->type.params[ first_idx]);
-                func->type.params[second_idx] = validateType(std::move(func)->type.params[second_idx]);
+        const auto& values = get<PackList>(pack)->values;
 
+        if (values.empty()) util::error("Folding over an empty pack: " + fold->stringify());
+        if (values.size() == 1) return values[0];
 
-                Environment args_env;
-                args_env[func->params[ first_idx].ID] = {{func->params[ first_idx].name}, std::make_shared<Value>(ret)  , func->type.params[ first_idx]};
-                args_env[func->params[second_idx].ID] = {{func->params[second_idx].name}, std::make_shared<Value>(value), func->type.params[second_idx]};
 
+        const size_t n = values.size();
 
-                ScopeGuard sg{this, args_env};
-
-                ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
-            }
-        }
+        // the separator goes between every 2 values:
+        // left to right starts at the first value, then: sep, v1, sep, v2, ...
+        if (l2r)
+            return this->fold(fold->op, values[0], true, 2 * (n - 1), [&] (const size_t k) -> const Value& {
+                return k % 2 ? values[k / 2 + 1] : sep;
+            });
 
-        return ret;
+        // right to left starts at the separator, then: v[n-1], v[n-2], sep, v[n-3], sep, ...
+        return this->fold(fold->op, sep, false, 2 * (n - 1), [&] (const size_t k) -> const Value& {
+            if (k == 0) return values[n - 1];
+            return k % 2 ? values[n - 1 - (k + 1) / 2] : sep;
+        });
     }
 
 
     Value operator()(const expr::BinaryFold *fold) {
+        count(fold);
         if (const auto& var = getVar(fold->ID); var) return var->first;
 
 
         Value pack = std::visit(*this, fold->pack->variant());
         Value init = std::visit(*this, fold->init->variant());
 
-        auto& packlist = get<PackList>(pack);
+        const auto& values = get<PackList>(pack)->values;
 
-        if (packlist->values.empty()) return init;
+        if (values.empty()) return init;
 
 
         // ! check this line later
         // Value ret = fold->left_to_right ? std::move(init) : packlist->values.back();
-        Value ret = std::move(init);
-
-        // std::vector<Value> values = std::move(packlist)->values;
-
-        // if (not fold->left_to_right) std::ranges::reverse(packlist->values);
-
-        std::vector<Value> values;
-        if (fold->left_to_right) {
-            if (fold->sep) {
-                const auto sep = std::visit(*this, fold->sep->variant());
-
-                for (auto& value : packlist->values) {
-                    values.push_back(sep);
-                    values.push_back(std::move(value));
-                }
-            }
-            else for (auto& value : packlist->values) values.push_back(std::move(value));
-        }
-        else {
-            if (fold->sep) {
-                const auto sep = std::visit(*this, fold->sep->variant());
-
-                for (auto& value : packlist->values) {
-                    values.push_back(std::move(value));
-                    values.push_back(sep);
-                }
-            }
-            else for (auto& value : packlist->values) values.push_back(std::move(value));
-
-            std::ranges::reverse(values);
-        }
-
-
-        const auto& op = ops.at(fold->op);
-
-        // can't have any syntax type since the pack consists of values, not expressions..
-        // unless...!
-        // TODO: allow for folding over syntax...maybe
-        checkNoSyntaxType(op->funcs);
-
-        expr::Closure* func;
-
-        const auto  first_idx = 1 - fold->left_to_right;
-        const auto second_idx =     fold->left_to_right;
-
-        // no overload resolution required
-        if (op->funcs.size() == 1) {
-            func = dynamic_cast<expr::Closure*>(op->funcs[0].get());
-            func->type.ret                = validateType(std::move(func)->type.ret               );
-            func->type.params[ first_idx] = validateType(std::move(func)->type.params[ first_idx]);
-            func->type.params[second_idx] = validateType(std::move(func)->type.params[second_idx]);
-
-
-            for (Environment args_env; const auto& value : values) {
-
-                typeCheck(ret, func->type.params[first_idx],
-                    "Type mis-match in Fold expressions with Infix operator '" + fold->op + 
-                    "', parameter '" + func->params[0].name +
-                    "' expected: " + func->type.params[0]->text() +
-                    ", got: " + stringify(ret) + " which is " + typeOf(ret)->text()
-                );
-
-
-                typeCheck(ret, func->type.params[second_idx],
-                        "Type mis-match in Fold expressions with Infix operator '" + fold->op + 
-                        "', parameter '" + func->params[1].name +
-                        "' expected: " + func->type.params[1]->text() +
-                        ", got: " + stringify(ret) + " which is " + typeOf(ret)->text()
-                );
-
-
-                args_env[func->params[ first_idx].ID] = {{func->params[ first_idx].name}, std::make_shared<Value>(ret)  , func->type.params[ first_idx]};
-                args_env[func->params[second_idx].ID] = {{func->params[second_idx].name}, std::make_shared<Value>(value), func->type.params[second_idx]};
-
-
-                ScopeGuard sg{this, args_env};
-
-                ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
-            }
-        }
-        else { // fuck me
-            checkNoSyntaxType(op->funcs);
-
-            for (Environment args_env; const auto& value : values) {
-                // auto type1 = validateType(typeOf(ret  ));
-                // auto type2 = validateType(typeOf(value));
-
-                func = resolveOverloadSet(op->OpName(), op->funcs, {ret, value});
-                // * may be not needed....idk tho ;-;
-                func->type.ret                = validateType(std::move(func)->type.ret               );
-                func->type.params[ first_idx] = validateType(std::move(func)->type.params[ first_idx]);
-                func->type.params[second_idx] = validateType(std::move(func)->type.params[second_idx]);
-
 
-                args_env[func->params[ first_idx].ID] = {{func->params[ first_idx].name}, std::make_shared<Value>(ret)  , func->type.params[ first_idx]};
-                args_env[func->params[second_idx].ID] = {{func->params[second_idx].name}, std::make_shared<Value>(value), func->type.params[second_idx]};
+        const size_t n = values.size();
+        const bool l2r = fold->left_to_right;
 
+        if (not fold->sep)
+            return this->fold(fold->op, std::move(init), l2r, n, [&] (const size_t k) -> const Value& { return values[l2r ? k : n - 1 - k]; });
 
-                ScopeGuard sg{this, args_env};
 
-                ret = checkReturnType(std::visit(*this, func->body->variant()), func->type.ret);
-            }
-        }
+        // a separator before every value. Right to left, that makes it: sep, v[n-1], sep, v[n-2], ...
+        const auto sep = std::visit(*this, fold->sep->variant());
 
-        return ret;
+        return this->fold(fold->op, std::move(init), l2r, 2 * n, [&] (const size_t k) -> const Value& {
+            if (k % 2 == 0) return sep;
+            return values[l2r ? k / 2 : n - 1 - k / 2];
+        });
     }
 
 
@@ -633,10 +484,10 @@ struct Visitor {
 
         const auto& obj = get<Object>(left);
 
-        const auto& found = std::ranges::find_if(obj.second->members,
-            [name = acc->name] (const auto& member) { return get<expr::Name>(member).stringify() == name; }
-        );
-        if (found == obj.second->members.end()) util::error("In assignment '" + ass->stringify() + "', Name '" + acc->name + "' doesn't exist in object: " + stringify(obj));
+        const auto slot = memberSlot(obj, acc);
+        if (not slot) util::error("In assignment '" + ass->stringify() + "', Name '" + acc->name + "' doesn't exist in object: " + stringify(obj));
+
+        const auto found = obj.second->members.begin() + *slot;
 
         const Value value = get<type::TypePtr>(*found)->text() == "Syntax" ? ass->rhs->variant() : std::visit(*this, ass->rhs->variant());
 
@@ -655,11 +506,10 @@ struct Visitor {
 
 
     Value spaceAccessAssign(const expr::Assignment *ass, expr::SpaceAccess *sa) {
-        const auto space = sa->global ? NSName(sa->spaces) : findNS(sa->spaces);
+        const auto space = sa->slot;
 
         // should never happen now that there is lexical analysis
-        if (not namespaces.contains(space)) util::error("Namespace `" + space + "` not found!");
-        if (not namespaces[space].contains(sa->name.ID)) util::error("Name `" + sa->name.name + "` with ID [" + std::to_string(sa->name.ID) + "] not found in space " + space);
+        if (not spaceAt(space).contains(sa->name.ID)) util::error("Name `" + sa->name.name + "` with ID [" + std::to_string(sa->name.ID) + "] not found in space " + NSName(sa->spaces));
 
         auto [_, __, type] = namespaces[space][sa->name.ID];
 
@@ -688,34 +538,21 @@ struct Visitor {
 
 
     Value refAssign(const expr::Assignment *ass, const expr::Name* name) {
+        const auto space = refSpace(name->ID, name->space);
 
-        for (const auto& [e, _] : std::views::reverse(env)) {
-            if (e.contains(name->ID)) {
-                const auto& [named_ref, value_ptr, type_ptr] = e.at(name->ID);
-                const auto& [_, space] = named_ref;
-
-                if (not namespaces.contains(space) or not namespaces[space].contains(name->ID)) 
-                    util::error();
-
-
-                // should never happen now that there is lexical analysis
-                if (not namespaces.contains(space)) util::error("Namespace `" + space + "` not found!");
-                if (not namespaces[space].contains(name->ID)) util::error("Name `" + name->name + "` with ID [" + std::to_string(name->ID) + "] not found in space " + space);
-
-                auto [__, ___, type] = namespaces[space][name->ID];
+        // should never happen now that there is lexical analysis
+        if (not spaceAt(space).contains(name->ID)) util::error("Name `" + name->name + "` with ID [" + std::to_string(name->ID) + "] not found in space [" + std::to_string(space) + ']');
 
-                auto value = std::visit(*this, ass->rhs->variant());
+        auto [__, ___, type] = namespaces[space][name->ID];
 
-                *get<value::ValuePtr>(namespaces[space][name->ID]) = typeCheck(value, std::move(type),
-                    "In assignment: " + ass->stringify() +
-                    "\nType mis-match! Expected: " + type->text() + ", got: " + typeOf(value)->text()
-                );
+        auto value = std::visit(*this, ass->rhs->variant());
 
-                return *get<value::ValuePtr>(namespaces[space][name->ID]) = std::move(value);
-            }
-        }
+        *get<value::ValuePtr>(namespaces[space][name->ID]) = typeCheck(value, std::move(type),
+            "In assignment: " + ass->stringify() +
+            "\nType mis-match! Expected: " + type->text() + ", got: " + typeOf(value)->text()
+        );
 
-        util::error();
+        return *get<value::ValuePtr>(namespaces[space][name->ID]) = std::move(value);
     }
 
 
@@ -726,8 +563,8 @@ struct Visitor {
         bool change{};
 
         // variable already exists. Check that type matches the rhs type
-        if (const auto& var = getVar(name->ID); var) {
-            if (isRef(name->ID)) return refAssign(ass, name);
+        if (const auto& var = getVar(name->ID, name->space); var) {
+            if (isRef(name->ID, name->space)) return refAssign(ass, name);
 
             if (type::shouldReassign(type)) {
                 // no need to check if it's a valid type since that already was checked when it was creeated
@@ -752,7 +589,7 @@ struct Visitor {
 
 
         if (type->text() == "Syntax")
-            return addVar(name->stringify(), name->ID, std::make_shared<value::Value>(ass->rhs->variant()), type);
+            return addVar(name->stringify(), name->ID, makeValue(ass->rhs->variant()), type);
 
 
         auto value = std::visit(*this, ass->rhs->variant());
@@ -779,13 +616,14 @@ struct Visitor {
         if (change) {
             if (not changeVar(name->ID, value)) util::error();
         }
-        else addVar(name->stringify(), name->ID, std::make_shared<value::Value>(value), type);
+        else addVar(name->stringify(), name->ID, makeValue(value), type);
 
         return value;
     }
 
 
     Value operator()(const expr::Assignment *ass) {
+        count(ass);
         // assigning to x.y should never create a variable "x.y" bu access x and change y;
         if (auto *acc = dynamic_cast<expr::Access*>(ass->lhs.get())) return accessAssign(ass, acc);
 
@@ -806,12 +644,13 @@ struct Visitor {
         return addVar(
             ass->lhs->stringify(),
             ass->lhs->ID,
-            std::make_shared<value::Value>(std::visit(*this, ass->rhs->variant()))
+            makeValue(std::visit(*this, ass->rhs->variant()))
         );
     }
 
 
     Value operator()(const expr::Class *cls) {
+        count(cls);
         if (const auto& var = getVar(cls->ID); var) return var->first;
 
 
@@ -866,6 +705,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Union *onion) {
+        count(onion);
         if (const auto& var = getVar(onion->ID); var) return var->first;
 
 
@@ -878,12 +718,36 @@ struct Visitor {
     }
 
 
+    // checks the access' inline cache first. On a miss, looks the name up in the object's shape and remembers the result
+    static std::optional<size_t> memberSlot(const Object& obj, const expr::Access *acc) {
+        const auto& members = *obj.second;
+
+        if (members.shape and members.shape == acc->cached_shape) return acc->cached_slot;
+
+        const auto slot = members.slot(acc->name);
+        if (slot and members.shape) {
+            acc->cached_shape = members.shape;
+            acc->cached_slot  = *slot;
+        }
+
+        return slot;
+    }
+
+
     Value objectAccess(const Object& obj, const std::string& name) {
-        const auto& found = std::ranges::find_if(obj.second->members, [&name] (const auto& member) { return get<0>(member).stringify() == name; });
-        if (found == obj.second->members.end()) util::error("Name '" + name + "' doesn't exist in object '" + /*acc->var->*/ stringify(obj) + '\'');
+        const auto slot = obj.second->slot(name);
+        if (not slot) util::error("Name '" + name + "' doesn't exist in object '" + /*acc->var->*/ stringify(obj) + '\'');
+
+        return objectMember(obj, *slot);
+    }
+
+
+    Value objectMember(const Object& obj, const size_t slot) {
+        const auto& found = obj.second->members.begin() + slot;
 
         if (std::holds_alternative<expr::Closure>(*get<ValuePtr>(*found))) {
-            const auto& closure = get<expr::Closure>(*get<ValuePtr>(*found));
+            // a copy. The one in the object holding on to the object would keep it alive forever
+            auto closure = get<expr::Closure>(*get<ValuePtr>(*found));
 
             // Environment capture_list;
             // for (const auto& [name, value] : obj.second->members)
@@ -901,6 +765,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Access *acc) {
+        count(acc);
 
         // in case user does self.xyz
         if (auto var = dynamic_cast<const expr::Name*>(acc->var.get()); var and var->name == "self") {
@@ -915,7 +780,14 @@ struct Visitor {
         }
 
         const auto& left = std::visit(*this, acc->var->variant());
-        if (std::holds_alternative<Object>(left)) return objectAccess(std::get<Object>(left), acc->name);
+        if (std::holds_alternative<Object>(left)) {
+            const auto& obj = get<Object>(left);
+
+            const auto slot = memberSlot(obj, acc);
+            if (not slot) util::error("Name '" + acc->name + "' doesn't exist in object '" + stringify(obj) + '\'');
+
+            return objectMember(obj, *slot);
+        }
 
 
         util::error("Can't access a non-class type!");
@@ -938,53 +810,23 @@ struct Visitor {
     }
 
 
-    std::string findNS(const std::vector<std::string> spaces) {
-        auto fixed_spaces = current_ns;
-
-        // * append_range only available in gcc-15
-        // * GH Actions doesn't support gcc-15
-        #if 0
-        fixed_spaces.append_range(spaces);
-        #else
-        for (const auto& space : spaces) fixed_spaces.push_back(space);
-        #endif
-
-
-        std::string name = NSName(spaces);
-        while (not namespaces.contains(name)) {
-            fixed_spaces.erase(fixed_spaces.end() - spaces.size(), fixed_spaces.end());
-
-            if (fixed_spaces.empty()) util::error("couldn't find space: " + name);
-
-            fixed_spaces.pop_back();
+    // the variables of the namespace in `slot`. Slots come from the analysis, so a slot it never handed out is a bug
+    Environment& spaceAt(const ssize_t slot) {
+        if (slot < 0) util::error("Namespace wasn't resolved!");
 
-            // * append_range only available in gcc-15
-            // * GH Actions doesn't support gcc-15
-            #if 0
-            fixed_spaces.append_range(spaces);
-            #else
-            for (const auto& space : spaces) fixed_spaces.push_back(space);
-            #endif
-
-            name = NSName(fixed_spaces);
-        }
-
-
-        return name;
+        if (static_cast<size_t>(slot) >= namespaces.size()) namespaces.resize(slot + 1);
+        return namespaces[slot];
     }
 
 
 
     Value operator()(const expr::Namespace *ns) {
+        count(ns);
         if (const auto& var = getVar(ns->ID); var) return var->first;
 
 
         ScopeGuard sg{this};
-        current_ns.push_back(ns->name);
-        util::Deferred d{[this] { current_ns.pop_back(); }};
-
-        const auto ns_name = NSName(current_ns); 
-        if (namespaces.contains(ns_name)) sg.addEnv(namespaces.at(ns_name));
+        sg.addEnv(spaceAt(ns->slot)); // when reopening a space
 
         Value value;
         // execute all the expressions in the namespace
@@ -995,6 +837,9 @@ struct Visitor {
 
         // then add the variables that resulted from that execution
         std::unordered_map<size_t, std::tuple<value::SpaceRef, value::ValuePtr, type::TypePtr>> members;
+        // `use space` inside a space makes those members its own too
+        env.back().first.merge(viewBindings(env.size() - 1));
+
         for (auto& [id, val] : env.back().first) {
             auto& [name, value, type] = val;
 
@@ -1004,12 +849,9 @@ struct Visitor {
         }
 
 
-        if (namespaces.contains(ns_name)) {
-            for (const auto& [id, var] : members) {
-                namespaces[ns_name][id] = var;
-            }
-        }
-        else namespaces[ns_name] = std::move(members);
+        // not a reference taken before running the body, nested spaces may have grown `namespaces` since
+        for (auto& space = namespaces[ns->slot]; auto& [id, var] : members)
+            space[id] = std::move(var);
 
 
         return value;
@@ -1017,14 +859,15 @@ struct Visitor {
 
 
     Value operator()(const expr::Use *use) {
+        count(use);
         if (const auto& var = getVar(use->ID); var) return var->first;
 
 
-        const auto space = use->global ? NSName(use->spaces) : findNS(use->spaces);
+        const auto space = use->slot;
 
-        if (not namespaces[space].contains(use->name.ID)) util::error("Name '" + use->name.name + "' not found in space " + space);
+        if (not spaceAt(space).contains(use->name.ID)) util::error("Name '" + use->name.name + "' not found in space " + NSName(use->spaces));
 
-        const auto& value = get<value::ValuePtr>(namespaces.at(space).at(use->name.ID));
+        const auto& value = get<value::ValuePtr>(namespaces[space].at(use->name.ID));
 
         return addVar(use->name.name, use->name.ID, value, type::builtins::Any(), space);
 
@@ -1032,54 +875,54 @@ struct Visitor {
     }
 
     Value operator()(const expr::UseSpace *use) {
+        count(use);
         if (const auto& var = getVar(use->ID); var) return var->first;
 
-        const auto space = use->global ? NSName(use->spaces) : findNS(use->spaces);
-
-        if (not namespaces.contains(space)) util::error("space '" + space + "' not found!");
+        const auto space = use->slot;
+        const auto& members = spaceAt(space);
 
-        Value v;
-        for (const auto& [ID, t_v] : namespaces.at(space)) {
-            const auto& [name, value, type] = t_v;
+        // the members stay where they are. Names the analysis resolved to them know which space to look in
+        views.emplace_back(env.size() - 1, space);
 
-            v = *value;
-            // util::error();
-            addVar(name.name, ID, value, type::builtins::Any(), space); // todo will figure something out for mutability, FUCK
-        }
-
-
-        for (const auto& [fullname, shortname] : use->children) {
-            namespaces.insert({shortname, namespaces[fullname]});
-        }
-
-        return v;
-        // return *get<2>(env[use->last_item_id]);
+        if (members.contains(use->last_item_id)) return *get<value::ValuePtr>(members.at(use->last_item_id));
+        return {};
     }
 
 
     Value operator()(const expr::Import *import) const {
-        const auto src = util::readFile(auto{import->path}.replace_extension(".pie").string());
-        const Tokens v = lex::lex(src);
-        if (v.empty()) util::error("Can't import an empty file!");
+        count(import);
+        if (not import->module) {
+            Parser p{modules::load(import->path), modules::canonicalName(import->path)};
+            auto [exprs, ops] = p.parse();
+
+            // modules get their own scope, the same way they get their own interpreter
+            analysis::LexicalAnalysis anal;
+            for (const auto& expr : exprs)
+                std::visit(anal, expr->variant());
 
-        Parser p{v, import->path};
+            analysis::optimize(exprs);
 
-        auto [exprs, ops] = p.parse();
+            import->module = std::make_shared<const expr::Import::Module>(std::move(exprs), std::move(ops));
+        }
+
+        Operators ops;
+        for (const auto& [name, op] : import->module->ops) ops[name] = op->clone();
 
         Value value;
-        for (Visitor v{std::move(ops)}; const auto& expr : exprs)
-            value = std::visit(v, std::move(expr)->variant());
+        for (Visitor v{std::move(ops)}; const auto& expr : import->module->exprs)
+            value = std::visit(v, expr->variant());
 
         return value;
     }
 
 
     Value operator()(const expr::SpaceAccess *sa) {
+        count(sa);
         if (const auto& var = getVar(sa->ID); var) return var->first;
 
-        const auto space = sa->global ? NSName(sa->spaces) : findNS(sa->spaces);
+        const auto space = sa->slot;
 
-        if (not namespaces[space].contains(sa->name.ID)) util::error("Name '" + sa->name.name + "' not found in space " + space);
+        if (not spaceAt(space).contains(sa->name.ID)) util::error("Name '" + sa->name.name + "' not found in space " + NSName(sa->spaces));
 
 
         return *get<value::ValuePtr>(namespaces[space][sa->name.ID]);
@@ -1088,29 +931,114 @@ struct Visitor {
     }
 
 
+    // the only alternative of value::Value a pattern can ever match, if there is one
+    std::optional<size_t> patternTag(const expr::Match::Case::Pattern& pattern) {
+        if (std::holds_alternative<expr::Match::Case::Pattern::Structure>(pattern.pattern)) {
+            for (const auto& pat : get<expr::Match::Case::Pattern::Structure>(pattern.pattern).patterns) patternTag(*pat); // caches nested literals
+
+            return value::alternativeOf<Object>();
+        }
+
+        const auto& single = get<expr::Match::Case::Pattern::Single>(pattern.pattern);
+
+        if (single.value and analysis::isLiteral(single.value)) {
+            single.constant = makeValue(std::visit(*this, single.value->variant()));
+            return single.constant->index(); // values of different alternatives are never equal
+        }
+
+        // builtin type names that aren't shadowed by anything
+        if (type::isBuiltin(single.type) and single.type->ID < 0) {
+            const auto name = single.type->text();
+
+            if (name == "Int"   ) return value::alternativeOf<BigInt     >();
+            if (name == "Double") return value::alternativeOf<double     >();
+            if (name == "Bool"  ) return value::alternativeOf<bool       >();
+            if (name == "String") return value::alternativeOf<std::string>();
+        }
+
+        return {};
+    }
+
+
+    void compileMatch(const expr::Match *m) {
+        m->dispatch.assign(std::variant_size_v<value::VariantType>, {});
+
+        for (size_t i{}; i < m->cases.size(); ++i) {
+            if (const auto tag = patternTag(*m->cases[i].pattern)) m->dispatch[*tag].push_back(i);
+            else for (auto& cases : m->dispatch) cases.push_back(i);
+        }
+
+        // the Int or String literal case `i` is written with, if it is one. `patternTag` already evaluated them
+        const auto literal = [m] (const size_t i) -> const Value* {
+            const auto& pattern = m->cases[i].pattern->pattern;
+            if (not std::holds_alternative<expr::Match::Case::Pattern::Single>(pattern)) return nullptr;
+
+            const auto& constant = get<expr::Match::Case::Pattern::Single>(pattern).constant;
+            if (constant and (std::holds_alternative<BigInt>(*constant) or std::holds_alternative<std::string>(*constant))) return constant.get();
+
+            return nullptr;
+        };
+
+        // a literal's own list: the cases of its kind, minus the ones written with a different literal. Still in order
+        const auto narrow = [m, &literal] <typename T> (std::unordered_map<T, std::vector<size_t>>& table) {
+            auto& cases = m->dispatch[value::alternativeOf<T>()];
+
+            for (const auto i : cases)
+                if (const auto lit = literal(i)) table.try_emplace(get<T>(*lit));
+
+            for (auto& [key, own] : table) {
+                for (const auto i : cases)
+                    if (const auto lit = literal(i); not lit or get<T>(*lit) == key) own.push_back(i);
+            }
+
+            std::erase_if(cases, [&literal] (const size_t i) { return literal(i) != nullptr; });
+        };
+
+        narrow(m->int_cases);
+        narrow(m->string_cases);
+    }
+
+
+    // the cases worth trying on `value`, in order
+    static const std::vector<size_t>& casesFor(const expr::Match *m, const Value& value) {
+        if (const auto n = std::get_if<BigInt>(&value); n and not m->int_cases.empty()) {
+            if (const auto it = m->int_cases.find(*n); it != m->int_cases.end()) return it->second;
+        }
+        else if (const auto s = std::get_if<std::string>(&value); s and not m->string_cases.empty()) {
+            if (const auto it = m->string_cases.find(*s); it != m->string_cases.end()) return it->second;
+        }
+
+        return m->dispatch[value.index()];
+    }
+
+
     bool match(const Value& value, const expr::Match::Case::Pattern& pattern) {
         if (std::holds_alternative<expr::Match::Case::Pattern::Single>(pattern.pattern)) {
-            const auto& [name, typ, val_expr] = get<expr::Match::Case::Pattern::Single>(pattern.pattern);
+            const auto& [name, typ, val_expr, constant] = get<expr::Match::Case::Pattern::Single>(pattern.pattern);
             const auto type = validateType(typ);
 
             // not gonna use typeCheck for now. Let's see how it goes
-            if (not (*type >= *typeOf(value))) return false;
+            // `Any` takes everything, no need to compute the type of the value
+            if (not type::shouldReassign(typ) and not (*type >= *typeOf(value))) return false;
 
-            if (val_expr) {
+            if (constant) {
+                if (value != *constant) return false;
+            }
+            else if (val_expr) {
                 const auto val = std::visit(*this, val_expr->variant());
                 if (value != val) return false;
             }
 
             if (name.name.length() != 0) {
-                addVar(name.name, name.ID, std::make_shared<value::Value>(value), type);
+                addVar(name.name, name.ID, makeValue(value), type);
             }
 
             return true;
         }
 
-        const auto& [type_name, patterns] = get<expr::Match::Case::Pattern::Structure>(pattern.pattern);
+        const auto& [type_name, patterns, space] = get<expr::Match::Case::Pattern::Structure>(pattern.pattern);
 
-        const auto var = getVar(type_name.ID);
+        const auto var = getVar(type_name.ID, space);
         if (not var)
             util::error("Name `" + type_name.name + "` in match expression does not name a constructor"); // shouldn't happen now that we have lexical analysis
 
@@ -1123,20 +1051,23 @@ struct Visitor {
         // const auto& cls = get<ClassValue>(type_value);
         // const type::TypePtr type = std::make_shared<type::LiteralType>(std::make_shared<ClassValue>(cls));
         const auto& type = get<type::TypePtr>(type_value);
-        // if (not (*type == *typeOf(value))) return false;
-        if (not (*type == *typeOf(value))) return false;
+        if (not std::holds_alternative<Object>(value)) return false;
+
+        const auto& obj = get<Object>(value);
+
+        // objects made by this very class share its blueprint. Only compare the text of the types when they don't
+        const auto cls = type::isClass(type), obj_cls = type::isClass(obj.first);
+        const bool same_class = cls and obj_cls and cls->cls->blueprint == obj_cls->cls->blueprint;
+        if (not same_class and not (*type == *typeOf(value))) return false;
 
         if (
-            type::isClass(type) and
-            patterns.size() > dynamic_cast<type::LiteralType*>(type.get())->cls->blueprint->fields.size()
+            cls and
+            patterns.size() > cls->cls->blueprint->fields.size()
         )
             util::error("Number of singles is greater than number of fields in class " + stringify(type));
 
 
-        const auto& obj = get<Object>(value);
-        if (obj.second->members.size() != obj.second->members.size()) util::error("idek what error message this should be..!");
-
-        for (const auto& [member, pat] : std::views::zip(get<Object>(value).second->members, patterns)) {
+        for (const auto& [member, pat] : std::views::zip(obj.second->members, patterns)) {
             if (not match(*get<ValuePtr>(member), *pat)) return false;
         }
 
@@ -1145,11 +1076,17 @@ struct Visitor {
 
 
     Value operator()(const expr::Match *m) {
+        count(m);
         if (const auto& var = getVar(m->ID); var) return var->first;
 
         const Value value = std::visit(*this, m->expr->variant());
 
-        for (const auto& kase : m->cases) {
+        if (m->dispatch.empty()) compileMatch(m);
+
+        // only the cases that could match this kind of value (or this very literal) are tried
+        for (const auto i : casesFor(m, value)) {
+            const auto& kase = m->cases[i];
+
             ScopeGuard sg{this};
             if (match(value, *kase.pattern)) {
                 bool guard = true;
@@ -1174,6 +1111,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Type* type) {
+        count(type);
         if (const auto& var = getVar(type->ID); var) return var->first;
 
         return validateType(type->type);
@@ -1181,6 +1119,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Loop *loop) {
+        count(loop);
         if (const auto& var = getVar(loop->ID); var) return var->first;
 
 
@@ -1220,7 +1159,7 @@ struct Visitor {
                         for (loop_counter = 0; loop_counter < limit; ++loop_counter) {
                             continued = false;
 
-                            addVar(var_name, id, std::make_shared<value::Value>(loop_counter)); // will change to "proper type" soon. for now, `Any` will do
+                            addVar(var_name, id, makeValue(loop_counter)); // will change to "proper type" soon. for now, `Any` will do
 
                             ret = std::visit(*this, loop->body->variant());
 
@@ -1251,7 +1190,7 @@ struct Visitor {
                         for (loop_counter = 0; get<bool>(cond); ++loop_counter) {
                             continued = false;
 
-                            addVar(var_name, id, std::make_shared<value::Value>(loop_counter));
+                            addVar(var_name, id, makeValue(loop_counter));
 
                             ret = std::visit(*this, loop->body->variant());
 
@@ -1287,7 +1226,7 @@ struct Visitor {
                         for (const auto& elt : list.elts->values) {
                             continued = false;
 
-                            addVar(var_name, id, std::make_shared<value::Value>(elt));
+                            addVar(var_name, id, makeValue(elt));
 
                             ret = std::visit(*this, loop->body->variant());
 
@@ -1318,7 +1257,7 @@ struct Visitor {
                         for (const auto& elt : pack->values) {
                             continued = false;
 
-                            addVar(var_name, id, std::make_shared<value::Value>(elt));
+                            addVar(var_name, id, makeValue(elt));
 
                             ret = std::visit(*this, loop->body->variant());
 
@@ -1374,7 +1313,7 @@ struct Visitor {
                             addVar(
                                 var_name,
                                 id,
-                                std::make_shared<value::Value>(std::visit(*this, next_call.variant()))
+                                makeValue(std::visit(*this, next_call.variant()))
                             );
 
                             ret = std::visit(*this, loop->body->variant());
@@ -1405,7 +1344,7 @@ struct Visitor {
             const auto& [var_name, id] = loop->var;
 
             for (loop_counter = 0; ; ++loop_counter) {
-                addVar(var_name, id, std::make_shared<value::Value>(loop_counter)); // will change to "proper type" soon. for now, `Any` will do
+                addVar(var_name, id, makeValue(loop_counter)); // will change to "proper type" soon. for now, `Any` will do
 
                 ret = std::visit(*this, loop->body->variant());
 
@@ -1430,6 +1369,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Break *brake) {
+        count(brake);
         broken = true;
         if (brake->expr) return std::visit(*this, brake->expr->variant());
         // if (brake->expr) return eval(brake->expr);
@@ -1438,6 +1378,7 @@ struct Visitor {
     }
 
     Value operator()(const expr::Continue *cont) {
+        count(cont);
         continued = true;
         if (cont->expr) return std::visit(*this, cont->expr->variant());
 
@@ -1447,6 +1388,7 @@ struct Visitor {
 
     //* only added to differentiate between expressions such as: 1 + 2 and (1 + 2)
     Value operator()(const expr::Grouping *g) {
+        count(g);
         if (const auto& var = getVar(g->ID); var) return var->first;
 
         return std::visit(*this, g->expr->variant());
@@ -1535,12 +1477,14 @@ struct Visitor {
     }
 
     Value operator()(const expr::UnaryOp *up) {
+        count(up);
         if (const auto& var = getVar(up->ID); var) return var->first;
 
+        const util::ProfileFrame frame{[up] { return up->op; }};
 
         const auto& op = ops.at(up->op);
         expr::Closure* func;
-        Environment args_env;
+        Value args[1]; // what each parameter gets
 
         if (op->funcs.size() == 1) {
             func = dynamic_cast<expr::Closure*>(op->funcs[0].get());
@@ -1549,12 +1493,12 @@ struct Visitor {
             if (func->type.params[0]->text() == "Syntax") {
                 // addVar(func->params.front(), up->expr->variant());
                 //* maybe should use Syntax() instead of Any();
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(up->expr->variant()), func->type.params[0]}; //? fixed
+                args[0] = up->expr->variant();
             }
             else {
                 func->type.params[0] = validateType(std::move(func)->type.params[0]);
 
-                const auto& arg = std::visit(*this, up->expr->variant());
+                auto arg = std::visit(*this, up->expr->variant());
 
                 typeCheck(arg, func->type.params[0],
                     "Type mis-match! Prefix operator '" + up->op + 
@@ -1564,19 +1508,23 @@ struct Visitor {
 
                 // addVar(func->params.front(), arg);
                 //* maybe should use Syntax() instead of Any();
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg), func->type.params[0]}; //? fixed
+                args[0] = std::move(arg);
             }
         }
         else { // do selection based on type
             checkNoSyntaxType(op->funcs);
 
-            const auto arg = std::visit(*this, up->expr->variant());
+            auto arg = std::visit(*this, up->expr->variant());
 
             func = resolveOverloadSet(op->OpName(), op->funcs, {arg});
 
-            args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg), func->type.params[0]}; //? fixed
+            args[0] = std::move(arg);
         }
 
+        if (const auto& direct = directCall(*func); direct.call) return callDirect(*func, direct, args);
+
+        Environment args_env;
+        args_env[func->params[0].ID] = {{func->params[0].name}, makeValue(std::move(args[0])), func->type.params[0]};
 
         ScopeGuard sg{this, args_env};
 
@@ -1601,12 +1549,14 @@ struct Visitor {
 
 
     Value operator()(const expr::BinOp *bp) {
+        count(bp);
         if (const auto& var = getVar(bp->ID); var) return var->first;
 
+        const util::ProfileFrame frame{[bp] { return bp->op; }};
 
         const auto& op = ops.at(bp->op);
         expr::Closure* func;
-        Environment args_env;
+        Value args[2]; // what each parameter gets
 
         if (op->funcs.size() == 1) {
             func = dynamic_cast<expr::Closure*>(op->funcs[0].get());
@@ -1614,12 +1564,12 @@ struct Visitor {
             // LHS
             if (func->type.params[0]->text() == "Syntax") {
                 // addVar(func->params[0], bp->lhs->variant());
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(bp->lhs->variant()), func->type.params[0]}; //? fixed
+                args[0] = bp->lhs->variant();
             }
             else {
                 func->type.params[0] = validateType(std::move(func)->type.params[0]);
 
-                const auto& arg1 = std::visit(*this, bp->lhs->variant());
+                auto arg1 = std::visit(*this, bp->lhs->variant());
 
                 typeCheck(arg1, func->type.params[0],
                     "Type mis-match! Infix operator '" + bp->op + 
@@ -1628,17 +1578,17 @@ struct Visitor {
                     ", got: " + stringify(arg1) + " which is " + typeOf(arg1)->text()
                 );
 
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg1), func->type.params[0]};
+                args[0] = std::move(arg1);
             }
 
             // RHS
             if (func->type.params[1]->text() == "Syntax") {
-                args_env[func->params[1].ID] = {{func->params[1].name}, std::make_shared<Value>(bp->rhs->variant()), func->type.params[1]};
+                args[1] = bp->rhs->variant();
             }
             else {
                 func->type.params[1] = validateType(std::move(func)->type.params[1]);
 
-                const auto& arg2 = std::visit(*this, bp->rhs->variant());
+                auto arg2 = std::visit(*this, bp->rhs->variant());
 
                 typeCheck(arg2, func->type.params[1],
                     "Type mis-match! Infix operator '" + bp->op + 
@@ -1647,20 +1597,20 @@ struct Visitor {
                     ", got: " + stringify(arg2) + " which is " + typeOf(arg2)->text()
                 );
 
-                args_env[func->params[1].ID] = {{func->params[1].name}, std::make_shared<Value>(arg2), func->type.params[1]};
+                args[1] = std::move(arg2);
             }
 
         }
         else {
             checkNoSyntaxType(op->funcs);
 
-            const auto arg1  = std::visit(*this, bp->lhs->variant());
-            const auto arg2  = std::visit(*this, bp->rhs->variant());
+            auto arg1 = std::visit(*this, bp->lhs->variant());
+            auto arg2 = std::visit(*this, bp->rhs->variant());
 
             func = resolveOverloadSet(op->OpName(), op->funcs, {arg1, arg2});
 
-            args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg1), func->type.params[0]};
-            args_env[func->params[1].ID] = {{func->params[1].name}, std::make_shared<Value>(arg2), func->type.params[1]};
+            args[0] = std::move(arg1);
+            args[1] = std::move(arg2);
         }
 
 
@@ -1680,6 +1630,11 @@ struct Visitor {
         //     f.captureThis(*func->self);
         // }
 
+        if (const auto& direct = directCall(*func); direct.call) return callDirect(*func, direct, args);
+
+        Environment args_env;
+        args_env[func->params[0].ID] = {{func->params[0].name}, makeValue(std::move(args[0])), func->type.params[0]};
+        args_env[func->params[1].ID] = {{func->params[1].name}, makeValue(std::move(args[1])), func->type.params[1]};
 
         ScopeGuard sg{this, args_env};
 
@@ -1704,12 +1659,14 @@ struct Visitor {
 
 
     Value operator()(const expr::PostOp *pp) {
+        count(pp);
         if (const auto& var = getVar(pp->ID); var) return var->first;
 
+        const util::ProfileFrame frame{[pp] { return pp->op; }};
 
         const auto& op = ops.at(pp->op);
         expr::Closure* func;
-        Environment args_env;
+        Value args[1]; // what each parameter gets
 
         if (op->funcs.size() == 1) {
 
@@ -1718,12 +1675,12 @@ struct Visitor {
 
             if (func->type.params[0]->text() == "Syntax") {
                 // addVar(func->params[0], pp->expr->variant());
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(pp->expr->variant()), func->type.params[0]}; //? fixed
+                args[0] = pp->expr->variant();
             }
             else {
                 func->type.params[0] = validateType(std::move(func)->type.params[0]);
 
-                const auto& arg = std::visit(*this, pp->expr->variant());
+                auto arg = std::visit(*this, pp->expr->variant());
 
                 typeCheck(arg, func->type.params[0],
                     "Type mis-match! Suffix operator '" + pp->op + 
@@ -1732,20 +1689,25 @@ struct Visitor {
                     ", got: " + stringify(arg) + " which is " + typeOf(arg)->text()
                 );
 
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg), func->type.params[0]}; //? fixed
+                args[0] = std::move(arg);
             }
 
         }
         else {
             checkNoSyntaxType(op->funcs);
 
-            const auto arg  = std::visit(*this, pp->expr->variant());
+            auto arg = std::visit(*this, pp->expr->variant());
 
             func = resolveOverloadSet(op->OpName(), op->funcs, {arg});
 
-            args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg), func->type.params[0]};
+            args[0] = std::move(arg);
         }
 
+        if (const auto& direct = directCall(*func); direct.call) return callDirect(*func, direct, args);
+
+        Environment args_env;
+        args_env[func->params[0].ID] = {{func->params[0].name}, makeValue(std::move(args[0])), func->type.params[0]};
+
         ScopeGuard sg{this, args_env};
 
         Value ret;
@@ -1770,8 +1732,11 @@ struct Visitor {
 
 
     Value operator()(const expr::CircumOp *cp) {
+        count(cp);
         if (const auto& var = getVar(cp->ID); var) return var->first;
 
+        const util::ProfileFrame frame{[cp] { return cp->op1; }};
+
         const auto& op = ops.at(cp->op1);
         expr::Closure* func;
         Environment args_env;
@@ -1783,7 +1748,7 @@ struct Visitor {
 
             if (func->type.params[0]->text() == "Syntax") {
                 // addVar(func->params[0], co->expr->variant());
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(cp->expr->variant()), func->type.params[0]}; //? fixed
+                args_env[func->params[0].ID] = {{func->params[0].name}, makeValue(cp->expr->variant()), func->type.params[0]}; //? fixed
             }
             else {
                 func->type.params[0] = validateType(std::move(func)->type.params[0]);
@@ -1797,7 +1762,7 @@ struct Visitor {
                     ", got: " + stringify(arg) + " which is " + typeOf(arg)->text()
                 );
 
-                args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg), func->type.params[0]}; //? fixed
+                args_env[func->params[0].ID] = {{func->params[0].name}, makeValue(arg), func->type.params[0]}; //? fixed
             }
         }
         else {
@@ -1807,7 +1772,7 @@ struct Visitor {
 
             func = resolveOverloadSet(op->OpName(), op->funcs, {arg});
 
-            args_env[func->params[0].ID] = {{func->params[0].name}, std::make_shared<Value>(arg), func->type.params[0]};
+            args_env[func->params[0].ID] = {{func->params[0].name}, makeValue(arg), func->type.params[0]};
         }
 
 
@@ -1833,8 +1798,10 @@ struct Visitor {
     };
 
     Value operator()(const expr::OpCall *oc) {
+        count(oc);
         if (const auto& var = getVar(oc->ID); var) return var->first;
 
+        const util::ProfileFrame frame{[oc] { return oc->first; }};
 
         const auto& op = ops.at(oc->first);
         expr::Closure* func;
@@ -1849,7 +1816,7 @@ struct Visitor {
 
             for (auto [arg_expr, param, param_type] : std::views::zip(oc->exprs, func->params, func->type.params)) {
                 if (param_type->text() == "Syntax") {
-                    args_env[param.ID] = {{param.name}, std::make_shared<Value>(arg_expr->variant()), param_type}; //?
+                    args_env[param.ID] = {{param.name}, makeValue(arg_expr->variant()), param_type}; //?
                 }
                 else {
                     param_type = validateType(std::move(param_type));
@@ -1864,7 +1831,7 @@ struct Visitor {
 
 
                     // addVar(func->params[0], std::visit(*this, co->expr->variant()));
-                    args_env[param.ID] = {{param.name}, std::make_shared<Value>(arg), param_type}; //? fix Any Type!!
+                    args_env[param.ID] = {{param.name}, makeValue(arg), param_type}; //? fix Any Type!!
                 }
             }
         }
@@ -1882,7 +1849,7 @@ struct Visitor {
             func = resolveOverloadSet(op->OpName(), op->funcs, args);
 
             for (const auto& [param, arg, type] : std::views::zip(func->params, args, func->type.params))
-                args_env[param.ID] = {{param.name}, std::make_shared<Value>(arg), type};
+                args_env[param.ID] = {{param.name}, makeValue(arg), type};
         }
 
 
@@ -1908,21 +1875,27 @@ struct Visitor {
     }
 
     std::optional<value::Value> objectIsCallable(const value::Object& obj) {
-        for (const auto& [name, type, value] : obj.second->members) {
-            if (name.name == "call" and type::isFunction(typeOf(*value))) {
-                get<expr::Closure>(*value).captureThis(obj);
-                return *value;
-            }
-        }
+        const auto slot = obj.second->slot("call");
+        if (not slot) return {};
 
-        return {};
+        const auto& value = get<ValuePtr>(obj.second->members[*slot]);
+        if (not type::isFunction(typeOf(*value))) return {};
+
+        auto call = get<expr::Closure>(*value); // same as members, the object's own copy doesn't get a `self`
+        call.captureThis(obj);
+        return call;
     };
 
+    // for every argument that expands a pack, its index and the pack. The values are read out of the pack itself when they're bound
+    using Expansions = std::vector<std::pair<size_t, PackList>>;
+
     Value operator()(const expr::Call *call) {
+        count(call);
         if (const auto& var = getVar(call->ID); var) return var->first;
 
-        // const auto args = std::move(call)->args;
-        const auto args = call->args;
+        if (call->inlined) return inlineCall(call, *call->inlined);
+
+        const auto& args = call->args;
 
 
         // for pack expansions at call site (there could be multiple of em)
@@ -1934,15 +1907,17 @@ struct Visitor {
         // the problem will be solved, and we'll even be able to allow
         // packs of syntax type: ...Syntax
         // for now, this is a hard problem for me
-        std::vector<std::pair<size_t, std::vector<Value>>> expand_at;
-        for (size_t i{}; i < args.size(); ++i) {
-            if (const auto expand = dynamic_cast<const expr::Expansion*>(args[i].get())) {
-                const auto pack = std::visit(*this, expand->pack->variant());
+        Expansions expand_at;
+        if (not call->positional) {
+            for (size_t i{}; i < args.size(); ++i) {
+                if (const auto expand = dynamic_cast<const expr::Expansion*>(args[i].get())) {
+                    const auto pack = std::visit(*this, expand->pack->variant());
 
-                if (not std::holds_alternative<PackList>(pack))
-                    util::error("Expansion applied on a non-pack variable: " + args[i]->stringify());
+                    if (not std::holds_alternative<PackList>(pack))
+                        util::error("Expansion applied on a non-pack variable: " + args[i]->stringify());
 
-                expand_at.push_back({i, get<PackList>(pack)->values});
+                    expand_at.push_back({i, get<PackList>(pack)});
+                }
             }
         }
 
@@ -1950,12 +1925,22 @@ struct Visitor {
         auto var = std::visit(*this, call->func->variant());
         if (std::holds_alternative<std::string>(var)) { // that dumb lol. but now it works
             const auto& name = std::get<std::string>(var);                                  // vvv not sure if this is moveable
-            if (isBuiltin(name)) return evaluateBuiltin(std::move(args), std::move(expand_at), call->named_args, name);
+            if (isBuiltin(name)) {
+                const util::ProfileFrame frame{[&name] { return name; }};
+                if (const auto& c = util::counters(); c) [[unlikely]] ++c->builtins[name];
+
+                return evaluateBuiltin(args, expand_at, call->named_args, name);
+            }
         }
 
+        // named after what's being called. Closures written right at the call site don't have a name
+        const util::ProfileFrame frame{[call] {
+            return dynamic_cast<const expr::Closure*>(call->func.get()) ? std::string{"<lambda>"} : call->func->stringify();
+        }};
+
 
         if (std::holds_alternative<expr::Closure>(var)) {
-            return closureCall(call, get<expr::Closure>(std::move(var)), std::move(args), std::move(expand_at));
+            return closureCall(call, get<expr::Closure>(std::move(var)), args, expand_at);
         }
 
 
@@ -1965,7 +1950,7 @@ struct Visitor {
         if (std::holds_alternative<value::Object>(var)) {
             const auto& obj = get<value::Object>(var);
             if (const auto callable = objectIsCallable(obj); callable) {
-                return closureCall(call, get<expr::Closure>(*std::move(callable)), std::move(args), std::move(expand_at));
+                return closureCall(call, get<expr::Closure>(*std::move(callable)), args, expand_at);
             }
         }
 
@@ -1989,12 +1974,33 @@ struct Visitor {
 
 
 
+    // whether the type of a parameter mentions something only known once the call binds its arguments,
+    // i.e. one of the parameters up to `p`, or a name captured by the function. Those types get evaluated in the arguments' scope.
+    // `p` indexes the positional parameters, which skip the named arguments, so it can be behind the parameter's own index
+    static bool findType(const expr::Closure& func, const size_t p, const expr::StringID& param, const type::TypePtr& type) {
+        const auto& deps = func.dependencies();
+
+        size_t i = p;
+        while (i < func.params.size() and func.params[i].name != param.name) ++i;
+
+        // it doesn't matter if there are multiple arguments with this name
+        // `validateType` will choose the lastly-bounded one
+        // we just need to proof that A parameter exists in order to call `validateType`
+        if (i < deps.params.size() and deps.params[i] <= p) return true;
+
+        // // look in the arguments env (from a partially evaluated function that yielded this function)
+        // for (const auto& [key, _] : func.args_env)
+        // or a name the function captured, or one a partial application bound. Each name in the type is looked up by its ID
+        return type->involvesID([&func] (const ssize_t ID) { return func.env.contains(ID) or func.isBound(ID); });
+    }
+
+
     struct ScopeGuard; // forward declaring so the below function knows about it
 
     void variadicCall(
         const expr::Closure& func,
         std::vector<std::pair<expr::StringID, type::TypePtr>>& pos_params,
-        const std::vector<std::pair<size_t, std::vector<Value>>>& expand_at,
+        const Expansions& expand_at,
         const std::vector<pie::expr::ExprPtr>& args,
         const size_t args_size,
         ScopeGuard& sg,
@@ -2012,25 +2018,6 @@ struct Visitor {
 
 
 
-        const auto findType = [&func] (const size_t p, const type::TypePtr& type) {
-            // it doesn't matter if there are multiple arguments with this name
-            // `validateType` will choose the lastly-bounded one
-            // we just need to proof that A parameter exists in order to call `validateType`
-            for (size_t i{}; i <= p; ++i)
-                if (type->involvesT(type::ExprType{std::make_shared<expr::Name>(func.params[i].name)}))
-                    return true;
-
-            // // look in the arguments env (from a partially evaluated function that yielded this function)
-            // for (const auto& [key, _] : func.args_env)
-            for (const auto& [_, obj] : func.env) {
-                const auto& [name, __, ___] = obj;
-                if (type->involvesT(type::ExprType{std::make_shared<expr::Name>(name.name)})) {
-                    return true;
-                }
-            }
-
-            return false;
-        };
 
 
         auto pack = makePack();
@@ -2045,7 +2032,7 @@ struct Visitor {
             Value value;
 
             if (param_index == variadic_index){
-                if (findType(param_index, type)) {
+                if (findType(func, param_index, sid, type)) {
                     // ScopeGuard sg{this, func.args_env, args_env};
                     ScopeGuard sg{this, func.env, args_env};
                     type = validateType(std::move(type));
@@ -2054,7 +2041,7 @@ struct Visitor {
 
                 for (size_t i{}; i < variadic_size; ++i) {
                     if (curr_expansion < expand_at.size() and arg_index == expand_at[curr_expansion].first) {
-                        value = std::move(expand_at[curr_expansion].second[pack_index++]);
+                        value = expand_at[curr_expansion].second->values[pack_index++];
 
                         value = typeCheck(value, type,
                             "Type mis-match! Parameter '" + name + "' expected type: " + type->text() + ", got: " + typeOf(value)->text()
@@ -2064,7 +2051,7 @@ struct Visitor {
                             captureEnvForPassedClosure(get<expr::Closure>(value));
 
 
-                        if (pack_index >= expand_at[curr_expansion].second.size()) {
+                        if (pack_index >= expand_at[curr_expansion].second->values.size()) {
                             ++arg_index;
                             ++curr_expansion;
                             pack_index = 0;
@@ -2096,10 +2083,10 @@ struct Visitor {
                 ++param_index;
 
                 // sg.addEnv({{name, {std::make_shared<Value>(value), type}}});
-                args_env[id] = {{name}, std::make_shared<Value>(std::move(pack)), std::move(type)};
+                args_env[id] = {{name}, makeValue(std::move(pack)), std::move(type)};
             }
             else {
-                if (findType(param_index, type)) {
+                if (findType(func, param_index, sid, type)) {
                     // ScopeGuard sg{this, func.args_env, args_env};
                     ScopeGuard sg{this, func.env, args_env};
                     type = validateType(std::move(type));
@@ -2107,7 +2094,7 @@ struct Visitor {
 
 
                 if (curr_expansion < expand_at.size() and arg_index == expand_at[curr_expansion].first) {
-                    value = expand_at[curr_expansion].second[pack_index++];
+                    value = expand_at[curr_expansion].second->values[pack_index++];
 
                     value = typeCheck(value, type,
                         "Type mis-match! Parameter '" + name + "' expected type: " + type->text() + ", got: " + typeOf(value)->text()
@@ -2117,7 +2104,7 @@ struct Visitor {
                         captureEnvForPassedClosure(get<expr::Closure>(value));
 
 
-                    if (pack_index >= expand_at[curr_expansion].second.size()) {
+                    if (pack_index >= expand_at[curr_expansion].second->values.size()) {
                         ++arg_index;
                         ++curr_expansion;
                         pack_index = 0;
@@ -2143,7 +2130,7 @@ struct Visitor {
 
                 ++param_index;
                 // sg.addEnv({{name, {std::make_shared<Value>(value), type}}});
-                args_env[id] = {{name}, std::make_shared<Value>(std::move(value)), std::move(type)};
+                args_env[id] = {{name}, makeValue(std::move(value)), std::move(type)};
             }
         }
 
@@ -2153,14 +2140,14 @@ struct Visitor {
                 pos_params[variadic_index].first.ID,
                 {
                     {pos_params[variadic_index].first.name},
-                    std::make_shared<Value>(makePack()),
+                    makeValue(makePack()),
                     pos_params[variadic_index].second
                 }
             }});
 
             args_env[pos_params[variadic_index].first.ID] = {
                 {pos_params[variadic_index].first.name},
-                std::make_shared<Value>(makePack()),
+                makeValue(makePack()),
                 std::move(pos_params)[variadic_index].second
             };
         }
@@ -2171,40 +2158,21 @@ struct Visitor {
     void regularCall(
         const expr::Closure& func,
         std::vector<std::pair<expr::StringID, type::TypePtr>>& pos_params,
-        std::vector<std::pair<size_t, std::vector<Value>>>& expand_at,
+        const Expansions& expand_at,
         const std::vector<pie::expr::ExprPtr>& args,
         const size_t args_size,
         // ScopeGuard& sg,
         Environment& args_env
     ) {
 
-        const auto findType = [&func] (const size_t p, const type::TypePtr& type) {
-            // it doesn't matter if there are multiple arguments with this name
-            // `validateType` will choose the lastly-bounded one
-            // we just need to proof that A parameter exists in order to call `validateType`
-            for (size_t i{}; i <= p; ++i)
-                if (type->involvesT(type::ExprType{std::make_shared<expr::Name>(func.params[i].name)}))
-                    return true;
-
-            // // look in the arguments env (from a partially evaluated function that yielded this function)
-            // for (const auto& [key, _] : func.args_env)
-            for (const auto& [_, obj] : func.env) {
-                const auto& [name, __, ___] = obj;
-                if (type->involvesT(type::ExprType{std::make_shared<expr::Name>(name.name)})) {
-                    return true;
-                }
-            }
-
-            return false;
-        };
 
         for (size_t i{}, p{}, curr{}; p < args_size; ++p, ++i) {
 
             if (curr < expand_at.size() and i == expand_at[curr].first) {
-                for (auto& val : expand_at[curr++].second) {
+                for (Value val : expand_at[curr++].second->values) {
                     auto& [sid, type] = pos_params[p];
                     const auto& [name, id] = sid;
-                    if (findType(p, type)) {
+                    if (findType(func, p, sid, type)) {
                         // ScopeGuard sg{this, func.args_env, args_env};
                         ScopeGuard sg{this, func.env, args_env};
                         type = validateType(std::move(type));
@@ -2221,14 +2189,14 @@ struct Visitor {
 
 
                     // sg.addEnv({{name, {std::make_shared<Value>(val), type}}});
-                    args_env[id] = {{name}, std::make_shared<Value>(std::move(val)), std::move(type)};
+                    args_env[id] = {{name}, makeValue(std::move(val)), std::move(type)};
                 }
                 --p; // the parameter index will have gone one too far. bring it back
             }
             else {
                 auto& [sid, type] = pos_params[p];
                 const auto& [name, id] = sid;
-                if (findType(p, type)) {
+                if (findType(func, p, sid, type)) {
                     // ScopeGuard sg{this, func.args_env, args_env};
                     ScopeGuard sg{this, func.env, args_env};
                     type = validateType(std::move(type));
@@ -2251,7 +2219,7 @@ struct Visitor {
                 }
 
                 // sg.addEnv({{name, {std::make_shared<Value>(value), type}}});
-                args_env[id] = {{name}, std::make_shared<Value>(std::move(value)), std::move(type)};
+                args_env[id] = {{name}, makeValue(std::move(value)), std::move(type)};
             }
         }
     }
@@ -2261,7 +2229,7 @@ struct Visitor {
         const expr::Call *call,
         expr::Closure func,
         const std::vector<pie::expr::ExprPtr>& args,
-        std::vector<std::pair<size_t, std::vector<Value>>> expand_at
+        const Expansions& expand_at
     ) {
 
         // // types are validate in operator()(const expr::Closure* c) for now
@@ -2269,9 +2237,14 @@ struct Visitor {
         // func.type.ret = validateType(std::move(func.type.ret));
         // // func.type.ret = validateType(std::move(func).type.ret); // is this better?
 
+        if (const auto& c = util::counters(); c) [[unlikely]] ++c->closure_calls;
+
         if (func.self) selves.push_back(*func.self);
         util::Deferred d{[this, cond = static_cast<bool>(func.self)] { if (cond) selves.pop_back(); }};
 
+        if (call->positional and args.size() == func.params.size() and func.dependencies().plain)
+            return positionalCall(func, args);
+
 
         // check for invalid named arguments
         for (const auto& [name, _] : call->named_args) {
@@ -2283,21 +2256,21 @@ struct Visitor {
         const bool is_variadic = std::ranges::any_of(func.type.params, [] (const auto& e) { return type::isVariadic(e); });
         const size_t args_size =
         args.size() +
-        std::ranges::fold_left(expand_at, size_t{}, [] (const auto& acc, const auto& elt) { return acc + elt.second.size(); }) // plus the expansions
+        std::ranges::fold_left(expand_at, size_t{}, [] (const auto& acc, const auto& elt) { return acc + elt.second->values.size(); }) // plus the expansions
         - expand_at.size(); // minus redundant packs (already expanded)
 
         if (not is_variadic and args_size + call->named_args.size() > func.params.size()) util::error("Too many arguments passed to function: " + call->stringify());
 
         // curry! 
         if (args_size + call->named_args.size() < func.params.size() - is_variadic) {
-            return partialApplication(call, func, args_size, std::move(expand_at), args, is_variadic);
+            return partialApplication(call, func, args_size, expand_at, args, is_variadic);
         }
 
 
         //* full call. Don't curry!
         // ScopeGuard sg{this, EnvTag::FUNC, func.args_env, func.env};
         ScopeGuard sg{this, EnvTag::FUNC, func.env};
-        Environment args_env; // in case the lambda needs to capture 
+        Environment args_env = boundArgs(func); // in case the lambda needs to capture 
 
 
         // !
@@ -2328,7 +2301,7 @@ struct Visitor {
                 //     captureEnvForPassedClosure(get<expr::Closure>(value));
             }
 
-            args_env[id] = {{name}, std::make_shared<Value>(std::move(value)), std::move(type)};
+            args_env[id] = {{name}, makeValue(std::move(value)), std::move(type)};
         }
 
 
@@ -2361,19 +2334,60 @@ struct Visitor {
 
 
 
-        if (
-            std::ranges::find_if(
-                func.params, [&type = func.type.ret](const auto& param) {
-                    return type->involvesT(type::ExprType{std::make_shared<expr::Name>(param.name)});
-                }
-            ) != func.params.cend()
-        ) {
+        // the return type can name a parameter, or one that a partial application bound
+        const bool ret_bound = not func.bound.empty() and func.type.ret->involvesID([&func] (const ssize_t ID) { return func.isBound(ID); });
+
+        if (func.dependencies().ret != expr::Closure::Dependencies::none or ret_bound) {
             // ScopeGuard sg{this, func.args_env, args_env};
             ScopeGuard sg{this, func.env, args_env};
             func.type.ret = validateType(std::move(func.type.ret));
         }
 
 
+        return callBody(func, sg, args_env);
+    }
+
+
+    // a positional call with exactly as many arguments as `func` has parameters, and nothing to work out from the types.
+    // every argument goes straight to its parameter, no sorting out named ones, packs, or currying
+    Value positionalCall(const expr::Closure& func, const std::vector<expr::ExprPtr>& args) {
+        ScopeGuard sg{this, EnvTag::FUNC, func.env};
+
+        Environment args_env = boundArgs(func);
+        args_env.reserve(args.size() + func.bound.size());
+
+        for (size_t i{}; i < args.size(); ++i) {
+            const auto& [name, id] = func.params[i];
+            const auto& type = func.type.params[i];
+
+            Value value;
+            if (type->text() == "Syntax") value = args[i]->variant();
+            else {
+                value = std::visit(*this, args[i]->variant());
+
+                value = typeCheck(value, type,
+                    "Type mis-match! Parameter '" + name + "' expected type: " + type->text() + ", got: " + typeOf(value)->text()
+                );
+
+                if (std::holds_alternative<expr::Closure>(value))
+                    captureEnvForPassedClosure(get<expr::Closure>(value));
+            }
+
+            args_env[id] = {{name}, makeValue(std::move(value)), type};
+        }
+
+        return callBody(func, sg, args_env);
+    }
+
+
+    // what earlier partial applications of `func` bound. One entry per argument, however many times it was curried
+    static Environment boundArgs(const expr::Closure& func) {
+        return {func.bound.begin(), func.bound.end()};
+    }
+
+
+    // runs a closure's body once its arguments are bound in `args_env`
+    Value callBody(const expr::Closure& func, ScopeGuard& sg, const Environment& args_env) {
         //* should I capture the env and bundle it with the function before returning it?
         if (type::isSyntax(func.type.ret)) return func.body->variant();
 
@@ -2406,6 +2420,54 @@ struct Visitor {
 
 
 
+    // a call the inliner marked. The callee is a plain closure with as many parameters as there are arguments,
+    // so the arguments are checked and bound straight into one frame and the body runs in it.
+    // Same order as any other call: the callee, then every argument in the caller's scope, then the frame
+    Value inlineCall(const expr::Call *call, const expr::Closure& func) {
+        if (const auto& c = util::counters(); c) [[unlikely]] ++c->inlined_calls;
+
+        const util::ProfileFrame profile{[call] { return call->func->stringify(); }};
+
+        std::visit(*this, call->func->variant()); // the closure is already known, but looking it up still has to happen
+
+        std::vector<Value> values;
+        values.reserve(func.params.size());
+
+        for (size_t i{}; i < func.params.size(); ++i) {
+            const auto& type = func.type.params[i];
+
+            Value value = std::visit(*this, call->args[i]->variant());
+
+            if (not type::shouldReassign(type) and not type::isAny(type)) {
+                value = typeCheck(value, type,
+                    "Type mis-match! Parameter '" + func.params[i].name + "' expected type: " + type->text() + ", got: " + typeOf(value)->text()
+                );
+            }
+
+            if (std::holds_alternative<expr::Closure>(value))
+                captureEnvForPassedClosure(get<expr::Closure>(value));
+
+            values.push_back(std::move(value));
+        }
+
+        ScopeGuard sg{this, EnvTag::FUNC};
+        auto& frame = env.back().first;
+
+        for (size_t i{}; i < func.params.size(); ++i) {
+            const auto& [name, id] = func.params[i];
+            frame[id] = {{name}, makeValue(std::move(values[i])), func.type.params[i]};
+        }
+
+        Value ret = std::visit(*this, func.body->variant());
+
+        if (std::holds_alternative<expr::Closure>(ret))
+            captureEnvForReturnedClosure(get<expr::Closure>(ret));
+
+        if (not type::shouldReassign(func.type.ret) and not type::isAny(func.type.ret)) checkReturnType(ret, func.type.ret);
+        return ret;
+    }
+
+
     // since all variables are always alive, it there is no need to capture variables...for now at least
     void captureEnvForReturnedClosure(const expr::Closure& c) {
         size_t found{};
@@ -2413,7 +2475,8 @@ struct Visitor {
         for (size_t i{}; i < env.size(); ++i)
             if (env[i].second == EnvTag::FUNC) found = i;
 
-        for (; found < env.size(); ++found) c.returnCapture(env[found].first);
+        for (; found < env.size(); ++found)
+            c.returnCapture(env[found].first);
     }
 
 
@@ -2440,13 +2503,13 @@ struct Visitor {
         const expr::Call *call,
         const expr::Closure& func,
         const size_t args_size,
-        std::vector<std::pair<size_t, std::vector<Value>>> expand_at,
-        std::vector<expr::ExprPtr> args, 
+        const Expansions& expand_at,
+        const std::vector<expr::ExprPtr>& args,
         const bool is_variadic
     ) {
         // ScopeGuard sg{this, EnvTag::FUNC, func.args_env, func.env};
         ScopeGuard sg{this, EnvTag::FUNC, func.env};
-        Environment args_env = func.env;
+        Environment args_env = boundArgs(func); // just the arguments. The environment stays with the closure as is
 
         for (const auto& [name, expr] : call->named_args) {
             type::TypePtr type;
@@ -2475,7 +2538,7 @@ struct Visitor {
             }
 
             // sg.addEnv({{name, {std::make_shared<Value>(value), type}}});
-            args_env[id] = {{name}, std::make_shared<Value>(std::move(value)), std::move(type)};
+            args_env[id] = {{name}, makeValue(std::move(value)), std::move(type)};
         }
 
 
@@ -2523,14 +2586,14 @@ struct Visitor {
                     pos_params[variadic_index].first.ID, 
                     {
                         {pos_params[variadic_index].first.name},
-                        std::make_shared<Value>(makePack()),
+                        makeValue(makePack()),
                         pos_params[variadic_index].second
                     }
                 }});
 
                 args_env[pos_params[variadic_index].first.ID] = {
                     {pos_params[variadic_index].first.name},
-                    std::make_shared<Value>(makePack()),
+                    makeValue(makePack()),
                     std::move(pos_params[variadic_index]).second
                 };
 
@@ -2546,7 +2609,7 @@ struct Visitor {
                 for (size_t i{}, p{}, curr{}; p < args_size; ++p, ++i) {
 
                     if (curr < expand_at.size() and i == expand_at[curr].first) {
-                        for (auto& val : expand_at[curr++].second) {
+                        for (Value val : expand_at[curr++].second->values) {
                             auto& [sid, type] = pos_params[p];
                             const auto& [name, id] = sid;
                             // if (findType(p, type)) type = validateType(std::move(type));
@@ -2560,7 +2623,7 @@ struct Visitor {
                                 captureEnvForPassedClosure(get<expr::Closure>(val));
 
                             // sg.addEnv({{name, {std::make_shared<Value>(val), type}}});
-                            args_env[id] = {{name}, std::make_shared<Value>(std::move(val)), std::move(type)};
+                            args_env[id] = {{name}, makeValue(std::move(val)), std::move(type)};
                         }
                         --p;
                     }
@@ -2584,41 +2647,23 @@ struct Visitor {
                             //     captureEnvForPassedClosure(get<expr::Closure>(value));
                         }
                         // sg.addEnv({{name, {std::make_shared<Value>(value), type}}});
-                        args_env[id] = {{name}, std::make_shared<Value>(std::move(value)), std::move(type)};
+                        args_env[id] = {{name}, makeValue(std::move(value)), std::move(type)};
                     }
                 }
             }
         }
 
         if (normal) {
-            const auto findType = [&func] (const size_t p, const type::TypePtr& type) {
-                // it doesn't matter if there are multiple arguments with this name
-                // `validateType` will choose the lastly-bounded one
-                // we just need to proof that A parameter exists in order to call `validateType`
-                for (size_t i{}; i <= p; ++i)
-                    if (type->involvesT(type::ExprType{std::make_shared<expr::Name>(func.params[i].name)}))
-                        return true;
-
-                // // look in the arguments env (from a partially evaluated function that yielded this function)
-                // for (const auto& [key, _] : func.args_env)
-                for (const auto& [_, obj] : func.env) {
-                    const auto& [name, __, ___] = obj;
-                    if (type->involvesT(type::ExprType{std::make_shared<expr::Name>(name.name)}))
-                        return true;
-                }
-
-                return false;
-            };
 
             // for(size_t i{}, curr{}; const auto& [param, expr] : std::views::zip(pos_params, args)) {
             for (size_t i{}, p{}, curr{}; p < args_size; ++p, ++i) {
 
                 if (curr < expand_at.size() and i == expand_at[curr].first) {
-                    for (auto& val : expand_at[curr++].second) {
+                    for (Value val : expand_at[curr++].second->values) {
                         auto& [sid, type] = pos_params[p];
                         const auto& [name, id] = sid;
 
-                        if (findType(p, type)) {
+                        if (findType(func, p, sid, type)) {
                             // ScopeGuard sg{this, func.args_env, args_env};
                             ScopeGuard sg{this, func.env, args_env};
                             type = validateType(std::move(type));
@@ -2633,14 +2678,14 @@ struct Visitor {
                             captureEnvForPassedClosure(get<expr::Closure>(val));
 
                         // sg.addEnv({{name, {std::make_shared<Value>(val), type}}});
-                        args_env[id] = {{name}, std::make_shared<Value>(std::move(val)), std::move(type)};
+                        args_env[id] = {{name}, makeValue(std::move(val)), std::move(type)};
                     }
                     --p;
                 }
                 else {
                     auto& [sid, type] = pos_params[p];
                     const auto& [name, id] = sid;
-                    if (findType(p, type)) {
+                    if (findType(func, p, sid, type)) {
                         // ScopeGuard sg{this, func.args_env, args_env};
                         ScopeGuard sg{this, func.env, args_env};
                         type = validateType(std::move(type));
@@ -2662,7 +2707,7 @@ struct Visitor {
                     }
 
                     // sg.addEnv({{name, {std::make_shared<Value>(value), type}}});
-                    args_env[id] = {{name}, std::make_shared<Value>(std::move(value)), std::move(type)};
+                    args_env[id] = {{name}, makeValue(std::move(value)), std::move(type)};
                 }
             }
         }
@@ -2670,7 +2715,21 @@ struct Visitor {
 
 
         // closure.captureArgs(args_env);
-        closure.capture(args_env);
+        closure.env = func.env;
+        closure.bound.assign(std::make_move_iterator(args_env.begin()), std::make_move_iterator(args_env.end()));
+
+        // types that mention none of func's parameters can't mention the ones that are bound now either,
+        // so there's nothing to look for in them again
+        using Deps = expr::Closure::Dependencies;
+        if (const auto& deps = func.dependencies();
+            deps.ret == Deps::none and std::ranges::all_of(deps.params, [] (const size_t p) { return p == Deps::none; }) and (deps.plain or func.bound.empty())
+        ) {
+            closure.deps = Deps{
+                .params = std::vector<size_t>(closure.params.size(), Deps::none),
+                .plain  = std::ranges::none_of(closure.type.params, [] (const auto& t) { return type::isVariadic(t); }),
+            };
+        }
+
         return closure;
     }
 
@@ -2703,13 +2762,51 @@ struct Visitor {
         util::error();
     }
 
-    // std::vector<std::tuple<expr::Name, type::TypePtr, ValuePtr>>
-    void initializeRestOfMembers(
-        value::Object& obj,
-        const std::vector<std::tuple<pie::expr::Name, pie::type::TypePtr, pie::expr::ExprPtr>>& fields,
-        const size_t starting_index
-    ) {
-        // std::vector<std::tuple<expr::Name, type::TypePtr, ValuePtr>> members;
+    // defaults that are unbound literals evaluate to the same thing every time, so they're evaluated and checked once per class
+    const auto& constantDefaults(const value::Fields& blueprint) {
+        if (blueprint.constants_ready) return blueprint.constants;
+
+        blueprint.constants.clear();
+        blueprint.constants.reserve(blueprint.fields.size());
+
+        for (const auto& [_, typ, expr] : blueprint.fields) {
+            const bool fixed_type = type::shouldReassign(typ) or (type::isBuiltin(typ) and typ->ID < 0 and not type::isSyntax(typ));
+
+            if (not analysis::isLiteral(expr) or not fixed_type) {
+                blueprint.constants.emplace_back();
+                continue;
+            }
+
+            const auto type = validateType(typ);
+            auto v = std::visit(*this, expr->variant());
+
+            // a mismatch is left to the regular path so it's only reported when the default is actually used
+            if (not type->typeCheck(this, v, typeOf(v))) {
+                blueprint.constants.emplace_back();
+                continue;
+            }
+
+            blueprint.constants.emplace_back(std::in_place, type, std::move(v));
+        }
+
+        blueprint.constants_ready = true;
+        return blueprint.constants;
+    }
+
+
+    void initializeRestOfMembers(value::Object& obj, const value::Fields& blueprint, const size_t starting_index) {
+        const auto& fields    = blueprint.fields;
+        const auto& constants = constantDefaults(blueprint);
+
+        // only constants left. Nothing can observe the earlier members, so no scope is needed
+        if (std::all_of(constants.cbegin() + starting_index, constants.cend(), [](const auto& c) { return c.has_value(); })) {
+            for (size_t index = starting_index; index < fields.size(); ++index) {
+                const auto& [type, v] = *constants[index];
+                obj.second->members.push_back({get<expr::Name>(fields[index]), type, makeValue(v)});
+            }
+
+            return;
+        }
 
         ScopeGuard sg{this};
         size_t index{};
@@ -2722,6 +2819,13 @@ struct Visitor {
         for (; index < fields.size(); ++index) {
             const auto& [name, typ, expr] = fields[index];
 
+            if (const auto& constant = constants[index]) {
+                const auto value = makeValue(constant->second);
+                addVar(name.name, name.ID, value, constant->first);
+                obj.second->members.push_back({name, constant->first, value});
+                continue;
+            }
+
             type::TypePtr type = typ;
 
             Value v;
@@ -2744,12 +2848,10 @@ struct Visitor {
 
 
             // maybe not allowing the usage of previous members in the initializers of other members is the way? not sure
-            const auto value = std::make_shared<Value>(v);
+            const auto value = makeValue(v);
             addVar(name.name, name.ID, value, type);
             obj.second->members.push_back({name, type, value});
         }
-
-        // return members;
     }
 
 
@@ -2765,9 +2867,8 @@ struct Visitor {
             util::error("Too many arguments passed to constructor of class: " + stringify(type) + "\nin constructor call:\n" + call->stringify());
 
 
-        value::Object obj{type, std::make_shared<Members>(
-            std::vector<std::tuple<expr::Name, type::TypePtr, value::ValuePtr>>() // reserve fields.size() elements
-        )};
+        value::Object obj{type, std::make_shared<Members>()};
+        obj.second->members.reserve(cls->blueprint->fields.size());
 
         // I woulda used a range for-loop but I need `arg` to be a reference and `value` cannot be a regular ref
         // const auto& [arg, value] : std::views::zip(call->args, obj->members)
@@ -2783,46 +2884,30 @@ struct Visitor {
 
 
 
-            obj.second->members.push_back({name, type, std::make_shared<value::Value>(v)});
+            obj.second->members.push_back({name, type, makeValue(v)});
         }
 
-        initializeRestOfMembers(obj, cls->blueprint->fields, call->args.size());
+        initializeRestOfMembers(obj, *cls->blueprint, call->args.size());
+        obj.second->shape = cls->blueprint->shape();
 
         return obj;
     }
 
 
     Value operator()(const expr::Closure *c) {
+        count(c);
         if (const auto& var = getVar(c->ID); var) return var->first;
 
+        const auto& deps = c->dependencies(); // before copying, so the copy (and every copy of it) already has them
         expr::Closure closure = *c; // copy to use for fix the types
 
-        // for (auto& type : closure.type.params) {
+        // types that depend on an earlier parameter wait for the call
         for (size_t i{}; i < closure.type.params.size(); ++i) {
             auto& type = closure.type.params[i];
-
-            bool found{};
-            for (size_t j{}; j < i; ++j) {
-                if (
-                    type->involvesT(
-                        type::ExprType{std::make_shared<expr::Name>(closure.params[j].name)}
-                    )
-                ) {
-                    found = true;
-                    break;
-                }
-            }
-
-            if (not found) type = validateType(std::move(type));
+            if (deps.params[i] >= i) type = validateType(std::move(type));
         }
 
-        if (
-            std::ranges::find_if(
-                closure.params, [&type = closure.type.ret](const auto& p) {
-                    return type->involvesT(type::ExprType{std::make_shared<expr::Name>(p.name)});
-                }
-            ) == closure.params.cend()
-        )
+        if (deps.ret == expr::Closure::Dependencies::none)
             closure.type.ret = validateType(std::move(closure.type.ret));
 
         // for (auto& type : closure.type.params) { type = validateType(std::move(type)); }
@@ -2833,6 +2918,7 @@ struct Visitor {
 
 
     Value operator()(const expr::Block *block) {
+        count(block);
         if (const auto& var = getVar(block->ID); var) return var->first;
 
 
@@ -2889,7 +2975,7 @@ struct Visitor {
             "panic", "true", "false", "input_str", "input_int",
 
             //* unary
-            "type_of", "len", "reset", "eval","neg", "not", "to_int", "to_double", "to_string", //"read_file"
+            "type_of", "len", "reset", "eval","neg", "not", "to_int", "to_double", "to_string",
 
             //* binary
             "get", "push", "pop",
@@ -2903,8 +2989,8 @@ struct Visitor {
             "str_slice", // (str, start, end, step), should I add anothee overload for (str, start, length)??
 
 
-            // //* File IO
-            // "read_whole", "read_line", "read_lines"
+            //* File IO
+            "read_file", "read_whole", "read_lines", "read_line", "has_line", "write_file", "append_file",
         })
             if (make_builtin(builtin) == func) return true;
 
@@ -2912,15 +2998,10 @@ struct Visitor {
     }
 
 
-    // the gate into the META operators!
-    Value evaluateBuiltin(
-        const std::vector<expr::ExprPtr> args,
-        const std::vector<std::pair<size_t, std::vector<Value>>> expand_at,
-        const std::unordered_map<std::string, expr::ExprPtr>& named_args,
-        std::string name
-    ) {
+    // every builtin that is a plain function of its arguments' values, by name
+    static auto builtinFunctions() {
         //* ============================ FUNCTIONS ============================
-        const auto functions = stdx::make_indexed_tuple<KeyFor>(
+        return stdx::make_indexed_tuple<KeyFor>(
             //* NULLARY FUNCTIONS
             MapEntry<
                 S<"true">,
@@ -2940,6 +3021,8 @@ struct Visitor {
                 S<"input_str">,
                 Func<"input_str",
                     decltype([](const auto&) {
+                        util::out().flush(); // prompts have to show up before we wait on the user
+
                         std::string out;
                         std::getline(std::cin, out);
                         return out;
@@ -2951,6 +3034,8 @@ struct Visitor {
                 S<"input_int">,
                 Func<"input_int",
                     decltype([](const auto&) {
+                        util::out().flush(); // prompts have to show up before we wait on the user
+
                         std::string out;
                         std::getline(std::cin, out);
                         if (not std::ranges::all_of(out, isdigit)) util::error("'__builtin_input_int' recieved a non-int \"" + out + "\"!");
@@ -3272,6 +3357,108 @@ struct Visitor {
                 >
             >{}
         );
+    }
+
+
+    template <typename Key, size_t ARITY>
+    static Value invokeBuiltin(Visitor& v, const Value* const args) {
+        const auto functions = builtinFunctions();
+
+        if constexpr (ARITY == 1) return execute(stdx::get<Key>(functions).value, &v, args[0]);
+        else return execute(stdx::get<Key>(functions).value, &v, args[0], args[1]);
+    }
+
+
+    // the builtins that only look at their arguments' values, so they can be called without going through evaluateBuiltin.
+    // eval and reset need the argument's AST, so they're not here
+    static decltype(expr::Closure::Direct::call) builtinCall(const std::string_view name, const size_t arity) {
+        if (arity == 1) {
+            if (name == "type_of"  ) return invokeBuiltin<S<"type_of"  >, 1>;
+            if (name == "len"      ) return invokeBuiltin<S<"len"      >, 1>;
+            if (name == "neg"      ) return invokeBuiltin<S<"neg"      >, 1>;
+            if (name == "not"      ) return invokeBuiltin<S<"not"      >, 1>;
+            if (name == "pop"      ) return invokeBuiltin<S<"pop"      >, 1>;
+            if (name == "to_int"   ) return invokeBuiltin<S<"to_int"   >, 1>;
+            if (name == "to_double") return invokeBuiltin<S<"to_double">, 1>;
+            if (name == "to_string") return invokeBuiltin<S<"to_string">, 1>;
+        }
+        else if (arity == 2) {
+            if (name == "get" ) return invokeBuiltin<S<"get" >, 2>;
+            if (name == "push") return invokeBuiltin<S<"push">, 2>;
+            if (name == "add" ) return invokeBuiltin<S<"add" >, 2>;
+            if (name == "sub" ) return invokeBuiltin<S<"sub" >, 2>;
+            if (name == "mul" ) return invokeBuiltin<S<"mul" >, 2>;
+            if (name == "div" ) return invokeBuiltin<S<"div" >, 2>;
+            if (name == "mod" ) return invokeBuiltin<S<"mod" >, 2>;
+            if (name == "pow" ) return invokeBuiltin<S<"pow" >, 2>;
+            if (name == "gt"  ) return invokeBuiltin<S<"gt"  >, 2>;
+            if (name == "geq" ) return invokeBuiltin<S<"geq" >, 2>;
+            if (name == "eq"  ) return invokeBuiltin<S<"eq"  >, 2>;
+            if (name == "leq" ) return invokeBuiltin<S<"leq" >, 2>;
+            if (name == "lt"  ) return invokeBuiltin<S<"lt"  >, 2>;
+        }
+
+        return nullptr;
+    }
+
+
+    // whether `func`'s body is just its parameters passed, in order, to one of the builtins above
+    const expr::Closure::Direct& directCall(const expr::Closure& func) {
+        if (func.direct) [[likely]] return *func.direct;
+
+        auto& direct = func.direct.emplace();
+
+        const auto call = dynamic_cast<const expr::Call*>(func.body.get());
+        if (not call or not call->named_args.empty() or call->args.size() != func.params.size()) return direct;
+
+        const auto callee = dynamic_cast<const expr::Name*>(call->func.get());
+        if (not callee or not isBuiltin(callee->name) or getVar(callee->ID)) return direct; // unless the name was reassigned
+
+        for (size_t i{}; i < func.params.size(); ++i) {
+            const auto arg = dynamic_cast<const expr::Name*>(call->args[i].get());
+            if (not arg or arg->ID != func.params[i].ID or arg->name != func.params[i].name) return direct;
+
+            const auto& type = func.type.params[i];
+            if (type->text() == "Syntax" or dynamic_cast<const type::VariadicType*>(type.get())) return direct;
+        }
+
+        direct.call = builtinCall(std::string_view{callee->name}.substr(10), func.params.size());
+        if (direct.call) direct.builtin = callee->name;
+
+        return direct;
+    }
+
+
+    // same as running the body: profiled and counted like the builtin call it stands for, then checked like any other return
+    Value callDirect(const expr::Closure& func, const expr::Closure::Direct& direct, const Value* const args) {
+        Value ret;
+        {
+            const util::ProfileFrame frame{[&direct] { return direct.builtin; }};
+            if (const auto& c = util::counters(); c) [[unlikely]] ++c->builtins[direct.builtin];
+
+            ret = direct.call(*this, args);
+        }
+
+        if (std::holds_alternative<expr::Closure>(ret)) {
+            const auto& f = get<expr::Closure>(ret);
+
+            captureEnvForReturnedClosure(f);
+            if (func.self) f.captureThis(*func.self);
+        }
+
+        checkReturnType(ret, func.type.ret);
+        return ret;
+    }
+
+
+    // the gate into the META operators!
+    Value evaluateBuiltin(
+        const std::vector<expr::ExprPtr>& args,
+        const Expansions& expand_at,
+        const std::unordered_map<std::string, expr::ExprPtr>& named_args,
+        std::string name
+    ) {
+        const auto functions = builtinFunctions();
 
 
 
@@ -3297,22 +3484,22 @@ struct Visitor {
 
         if (name == "true")  {
             arity_check(0);
-            return execute<0>(stdx::get<S<"true">>(functions).value, {}, this);
+            return execute(stdx::get<S<"true">>(functions).value, this);
         }
 
         if (name == "false") {
             arity_check(0);
-            return execute<0>(stdx::get<S<"false">>(functions).value, {}, this);
+            return execute(stdx::get<S<"false">>(functions).value, this);
         }
 
         if (name == "input_str") {
             arity_check(0);
-            return execute<0>(stdx::get<S<"input_str">>(functions).value, {}, this);
+            return execute(stdx::get<S<"input_str">>(functions).value, this);
         }
 
         if (name == "input_int") {
             arity_check(0);
-            return execute<0>(stdx::get<S<"input_int">>(functions).value, {}, this);
+            return execute(stdx::get<S<"input_int">>(functions).value, this);
         }
 
 
@@ -3352,6 +3539,12 @@ struct Visitor {
 
 
 
+        using std::operator""sv;
+
+        const auto file_io = {"read_file"sv, "read_whole"sv, "read_lines"sv, "read_line"sv, "has_line"sv, "write_file"sv, "append_file"sv};
+        if (std::ranges::find(file_io, name) != file_io.end()) return fileBuiltin(args, name, arity_check);
+
+
         if (name == "neg" or name == "not" or name == "reset") arity_check(1); // just for now..
 
 
@@ -3371,19 +3564,18 @@ struct Visitor {
 
 
 
-        if (name == "type_of"  ) return execute<1>(stdx::get<S<"type_of"   >>(functions).value, {value1}, this);
-        if (name == "len"      ) return execute<1>(stdx::get<S<"len"       >>(functions).value, {value1}, this);
-        if (name == "eval"     ) return execute<1>(stdx::get<S<"eval"      >>(functions).value, {value1}, this);
-        if (name == "neg"      ) return execute<1>(stdx::get<S<"neg"       >>(functions).value, {value1}, this);
-        if (name == "not"      ) return execute<1>(stdx::get<S<"not"       >>(functions).value, {value1}, this);
-        if (name == "pop"      ) return execute<1>(stdx::get<S<"pop"       >>(functions).value, {value1}, this);
-        if (name == "to_int"   ) return execute<1>(stdx::get<S<"to_int"    >>(functions).value, {value1}, this);
-        if (name == "to_double") return execute<1>(stdx::get<S<"to_double" >>(functions).value, {value1}, this);
-        if (name == "to_string") return execute<1>(stdx::get<S<"to_string" >>(functions).value, {value1}, this);
+        if (name == "type_of"  ) return execute(stdx::get<S<"type_of"   >>(functions).value, this, value1);
+        if (name == "len"      ) return execute(stdx::get<S<"len"       >>(functions).value, this, value1);
+        if (name == "eval"     ) return execute(stdx::get<S<"eval"      >>(functions).value, this, value1);
+        if (name == "neg"      ) return execute(stdx::get<S<"neg"       >>(functions).value, this, value1);
+        if (name == "not"      ) return execute(stdx::get<S<"not"       >>(functions).value, this, value1);
+        if (name == "pop"      ) return execute(stdx::get<S<"pop"       >>(functions).value, this, value1);
+        if (name == "to_int"   ) return execute(stdx::get<S<"to_int"    >>(functions).value, this, value1);
+        if (name == "to_double") return execute(stdx::get<S<"to_double" >>(functions).value, this, value1);
+        if (name == "to_string") return execute(stdx::get<S<"to_string" >>(functions).value, this, value1);
 
 
         // all the rest of those funcs expect 2 arguments
-        using std::operator""sv;
 
         const auto eager = {"get"sv, "push"sv, "add"sv, "sub"sv, "mul"sv, "div"sv, "mod"sv, "pow"sv, "gt"sv, "geq"sv, "eq"sv, "leq"sv, "lt"sv};
         if (std::ranges::find(eager, name) != eager.end()) {
@@ -3391,20 +3583,20 @@ struct Visitor {
             const auto& value2 = std::visit(*this, args[1]->variant());
 
             // this is disgusting..I know
-            if (name == "get" ) return execute<2>(stdx::get<S<"get" >>(functions).value, {value1, value2}, this);
-            if (name == "push") return execute<2>(stdx::get<S<"push">>(functions).value, {value1, value2}, this);
-
-            if (name == "add") return execute<2>(stdx::get<S<"add">>(functions).value, {value1, value2}, this);
-            if (name == "sub") return execute<2>(stdx::get<S<"sub">>(functions).value, {value1, value2}, this);
-            if (name == "mul") return execute<2>(stdx::get<S<"mul">>(functions).value, {value1, value2}, this);
-            if (name == "div") return execute<2>(stdx::get<S<"div">>(functions).value, {value1, value2}, this);
-            if (name == "mod") return execute<2>(stdx::get<S<"mod">>(functions).value, {value1, value2}, this);
-            if (name == "pow") return execute<2>(stdx::get<S<"pow">>(functions).value, {value1, value2}, this);
-            if (name == "gt" ) return execute<2>(stdx::get<S<"gt" >>(functions).value, {value1, value2}, this);
-            if (name == "geq") return execute<2>(stdx::get<S<"geq">>(functions).value, {value1, value2}, this);
-            if (name == "eq" ) return execute<2>(stdx::get<S<"eq" >>(functions).value, {value1, value2}, this);
-            if (name == "leq") return execute<2>(stdx::get<S<"leq">>(functions).value, {value1, value2}, this);
-            if (name == "lt" ) return execute<2>(stdx::get<S<"lt" >>(functions).value, {value1, value2}, this);
+            if (name == "get" ) return execute(stdx::get<S<"get" >>(functions).value, this, value1, value2);
+            if (name == "push") return execute(stdx::get<S<"push">>(functions).value, this, value1, value2);
+
+            if (name == "add") return execute(stdx::get<S<"add">>(functions).value, this, value1, value2);
+            if (name == "sub") return execute(stdx::get<S<"sub">>(functions).value, this, value1, value2);
+            if (name == "mul") return execute(stdx::get<S<"mul">>(functions).value, this, value1, value2);
+            if (name == "div") return execute(stdx::get<S<"div">>(functions).value, this, value1, value2);
+            if (name == "mod") return execute(stdx::get<S<"mod">>(functions).value, this, value1, value2);
+            if (name == "pow") return execute(stdx::get<S<"pow">>(functions).value, this, value1, value2);
+            if (name == "gt" ) return execute(stdx::get<S<"gt" >>(functions).value, this, value1, value2);
+            if (name == "geq") return execute(stdx::get<S<"geq">>(functions).value, this, value1, value2);
+            if (name == "eq" ) return execute(stdx::get<S<"eq" >>(functions).value, this, value1, value2);
+            if (name == "leq") return execute(stdx::get<S<"leq">>(functions).value, this, value1, value2);
+            if (name == "lt" ) return execute(stdx::get<S<"lt" >>(functions).value, this, value1, value2);
 
             util::error("This shouldn't happen. File a bug report!");
 
@@ -3449,7 +3641,7 @@ struct Visitor {
             const auto& value2 = std::visit(*this, args[1]->variant());
             const auto& value3 = std::visit(*this, args[2]->variant());
 
-            return execute<3>(stdx::get<S<"set">>(functions).value, {value1, value2, value3}, this);
+            return execute(stdx::get<S<"set">>(functions).value, this, value1, value2, value3);
         }
 
         if (name == "str_slice") {
@@ -3487,16 +3679,123 @@ struct Visitor {
 
 
         // const auto& value3 = std::visit(*this, call->args[2]->variant());
-        // if (name == "conditional") return execute<3>(stdx::get<S<"conditional">>(functions).value, {value1, value2, value3}, this);
+        // if (name == "conditional") return execute(stdx::get<S<"conditional">>(functions).value, this, value1, value2, value3);
+
+
+        util::error("Calling a builtin fuction that doesn't exist!");
+    }
+
+
+    Value fileBuiltin(const std::vector<expr::ExprPtr>& args, const std::string& name, const auto& arity_check) {
+        const auto expect = [&] <typename T> (const Value& v) -> const T& {
+            if (not std::holds_alternative<T>(v))
+                util::error<except::InvalidArgument>("Wrong type passed to \"__builtin_" + name + "\": " + stringify(v));
+
+            return get<T>(v);
+        };
+
+
+        if (name == "write_file" or name == "append_file") {
+            arity_check(2);
+            const auto path = expect.template operator()<std::string>(std::visit(*this, args[0]->variant()));
+            const auto text = expect.template operator()<std::string>(std::visit(*this, args[1]->variant()));
+
+            std::ofstream out{path, std::ios::binary | (name == "append_file" ? std::ios::app : std::ios::trunc)};
+            if (not out.is_open()) util::error("Couldn't open file \"" + path + "\" for writing!");
+
+            // streamed out in 64K chunks. Writes that big skip the stream's own buffer and go straight to the file
+            constexpr size_t chunk = 1 << 16;
+            for (size_t written{}; written < text.size() and out; written += chunk)
+                out.write(text.data() + written, static_cast<std::streamsize>(std::min(chunk, text.size() - written)));
+
+            if (not out.flush()) util::error("Couldn't write to file \"" + path + "\"!");
+
+            return static_cast<BigInt>(text.size());
+        }
+
+
+        arity_check(1);
+        const auto arg = std::visit(*this, args[0]->variant());
+
+        // reading from an iterator made by `read_lines`. The object owns its reader, the file goes when the object does
+        if (name == "read_line" or name == "has_line") {
+            const auto& obj = expect.template operator()<Object>(arg);
+            if (obj.first != lineReaderClass())
+                util::error<except::InvalidArgument>("\"__builtin_" + name + "\" expects an object made by \"__builtin_read_lines\": " + stringify(arg));
+
+            auto& native = obj.second->native;
+            const auto reader = static_cast<util::LineReader*>(native.get());
+
+            if (name == "has_line") {
+                if (reader and reader->hasNext()) return true;
+
+                native.reset(); // done with it. let go of the file
+                return false;
+            }
+
+            if (not reader or not reader->hasNext()) util::error("\"__builtin_read_line\" read past the end of the file!");
+
+            return std::string{reader->next()};
+        }
+
+
+        const auto& path = expect.template operator()<std::string>(arg);
+
+        if (name == "read_whole") return std::string{util::MappedFile{path}.view()};
+
+        if (name == "read_file") {
+            util::LineReader reader{path};
+
+            std::vector<Value> lines;
+            while (reader.hasNext()) lines.emplace_back(std::string{reader.next()});
+
+            return makeList(std::move(lines));
+        }
+
+        if (name == "read_lines") {
+            const auto& type      = lineReaderClass();
+            const auto& blueprint = *type::isClass(type)->cls->blueprint;
+
+            value::Object obj{type, std::make_shared<Members>()};
+            obj.second->native = std::make_shared<util::LineReader>(path);
+
+            // the methods are taken as they are, not evaluated here, so they don't capture whatever scope this is called in
+            for (const auto& [field, typ, expr] : blueprint.fields)
+                obj.second->members.push_back({field, validateType(typ), makeValue(dynamic_cast<const expr::Closure&>(*expr))});
+
+            obj.second->shape = blueprint.shape();
+            return obj;
+        }
 
 
         util::error("Calling a builtin fuction that doesn't exist!");
     }
 
 
+    // objects from `__builtin_read_lines` follow the iterator protocol, so they can be looped over.
+    // the class never goes through the analysis: every name in it is unbound (`self`, and builtins), so they're looked up by name,
+    // and the class is made from its fields directly instead of evaluated, so it doesn't depend on the scope it's first needed in
+    const type::TypePtr& lineReaderClass() {
+        if (line_reader) return line_reader;
+
+        Parser p{lex::lex(
+            "class {"
+            "    hasNext = (): Bool => __builtin_has_line(self);"
+            "    next = (): String => __builtin_read_line(self);"
+            "};"
+        )};
+
+        const auto [exprs, _] = p.parse();
+        const auto& cls = dynamic_cast<const expr::Class&>(*exprs[0]);
+
+        line_reader = std::make_shared<type::LiteralType>(std::make_shared<value::ClassValue>(std::make_shared<value::Fields>(cls.fields)));
+        return line_reader;
+    }
+
+
     Value builtinPrint(
         const std::vector<expr::ExprPtr>& args,
-        const std::vector<std::pair<size_t, std::vector<Value>>>& expand_at,
+        const Expansions& expand_at,
         const std::unordered_map<std::string, expr::ExprPtr>& named_args
     ) {
         if (args.empty()) util::error("'print' requires at least 1 positional argument passed!");
@@ -3517,7 +3816,7 @@ struct Visitor {
         Value ret;
         for(size_t i{}, curr{}; auto& arg : args) {
             if (curr < expand_at.size() and i++ == expand_at[curr].first) {
-                for (const auto& e : expand_at[curr++].second) {
+                for (const auto& e : expand_at[curr++].second->values) {
                     if (separator) print(*separator, no_newline);
 
                     print(e, no_newline);
@@ -3537,14 +3836,27 @@ struct Visitor {
 
         if (named_args.contains("end"))
                 print(std::visit(*this, named_args.at("end")->variant()), no_newline);
-        else puts(""); // print the new line in the end.
+        else util::out().write('\n'); // print the new line in the end.
+
+        if (util::out().unbuffered) util::out().flush();
 
         return ret;
     }
 
 
 
-    void print(const Value& value, const bool new_line = true) const { std::print("{}{}", stringify(value), new_line? '\n' : '\0'); }
+    void print(const Value& value, const bool new_line = true) const {
+        auto& out = util::out();
+
+        // the common ones are written straight into the output buffer
+        if      (const auto v = std::get_if<BigInt     >(&value)) out.write(static_cast<long long>(*v));
+        else if (const auto v = std::get_if<double     >(&value)) out.write(*v);
+        else if (const auto v = std::get_if<bool       >(&value)) out.write(*v ? "true" : "false");
+        else if (const auto v = std::get_if<std::string>(&value)) out.write(*v);
+        else out.write(stringify(value));
+
+        if (new_line) out.write('\n');
+    }
 
 
     type::TypePtr validateType(const type::TypePtr& type) {
@@ -3553,12 +3865,12 @@ struct Visitor {
 
 
 
-        if (auto var = getVar(type->ID); var) {
+        if (auto var = getVar(type->ID, type->space); var) {
             if (auto t = typeOf(var->first); not type::isType(t)) {
                 if (type::isFunction(t))
-                    return std::make_shared<type::ConceptType>(std::make_shared<value::Value>(std::move(var)->first));
+                    return std::make_shared<type::ConceptType>(makeValue(std::move(var)->first));
 
-                return std::make_shared<type::ValueType>(std::make_shared<value::Value>(std::move(var)->first));
+                return std::make_shared<type::ValueType>(makeValue(std::move(var)->first));
             }
 
             if (std::holds_alternative<type::TypePtr>(var->first))
@@ -3579,7 +3891,7 @@ struct Visitor {
 
             return 
             std::make_shared<type::ValueType>(
-                std::make_shared<value::Value>(std::move(value))
+                makeValue(std::move(value))
             );
         }
 
@@ -3811,14 +4123,17 @@ struct Visitor {
 
     void scope([[maybe_unused]] Visitor::EnvTag tag = Visitor::EnvTag::NONE) { env.push_back({{}, tag}); }
 
-    void unscope() { env.pop_back(); }
+    void unscope() {
+        env.pop_back();
+        while (not views.empty() and views.back().first >= env.size()) views.pop_back();
+    }
 
     Value addVar(
         const std::string& name,
         const size_t ID,
         const ValuePtr& v,
         const type::TypePtr& t = type::builtins::Any(),
-        const std::string& space = ""
+        const ssize_t space = -1
     ) {
         // if (const auto cls = type::isClass(t)) {
         //     auto obj = get<value::Object>(v);
@@ -3857,26 +4172,58 @@ struct Visitor {
     // }
 
 
-    bool isRef(const size_t ID) const {
-        for (const auto& [e, _] : std::views::reverse(env)) {
-            if (e.contains(ID)) {
-                const auto& [named_ref, _, __] = e.at(ID);
-                return named_ref.isRef();
+    bool isRef(const size_t ID, const ssize_t space = -1) const { return refSpace(ID, space) >= 0; }
+
+    // slot of the namespace the closest `ID` lives in, if it got there through `use` or `use space`.
+    // `space` is the one the analysis resolved the name to, if it's a member (`Expr::space`)
+    ssize_t refSpace(const size_t ID, const ssize_t space = -1) const {
+        for (const auto& [e, _] : std::views::reverse(env))
+            if (e.contains(ID)) return get<value::SpaceRef>(e.at(ID)).space;
+
+        return inSpace(ID, space) ? space : -1;
+    }
+
+    bool inSpace(const size_t ID, const ssize_t space) const {
+        return space >= 0 and static_cast<size_t>(space) < namespaces.size() and namespaces[space].contains(ID);
+    }
+
+
+    // the members of the spaces used in frame `frame`. A space that uses another takes these as its own
+    Environment viewBindings(const size_t frame) const {
+        Environment e;
+
+        for (const auto& [f, space] : views) {
+            if (f != frame) continue;
+
+            for (const auto& [ID, var] : namespaces[space]) {
+                const auto& [name, value, _] = var;
+                e[ID] = {{name.name, space}, value, type::builtins::Any()}; // todo will figure something out for mutability, FUCK
             }
         }
 
-
-        return false;
+        return e;
     }
 
-    std::optional<std::pair<Value, type::TypePtr>> getVar(const size_t ID) const {
+    std::optional<std::pair<Value, type::TypePtr>> getVar(const size_t ID, const ssize_t space = -1) const {
+        const auto& counters = util::counters();
+        if (counters) [[unlikely]] ++counters->env_lookups;
+
         for (const auto& [e, _] : std::views::reverse(env)) {
+            if (counters) [[unlikely]] ++counters->env_frames;
+
             if (e.contains(ID)) {
                 const auto& [named_ref, value_ptr, type_ptr] = e.at(ID);
                 return {{*value_ptr, type_ptr}};
             }
         }
 
+        // not bound directly, maybe a member a `use space` brought in. Only names the analysis resolved to one get here
+        if (inSpace(ID, space)) {
+            if (counters) [[unlikely]] ++counters->env_frames; // the space is one more scope to look in
+
+            return {{*get<value::ValuePtr>(namespaces[space].at(ID)), type::builtins::Any()}};
+        }
+
         // if (env.contains(ID)) {
         //     const auto& [_, value, type] = env.at(ID);
         //     return {{*value, type}};
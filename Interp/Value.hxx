@@ -5,6 +5,8 @@
 #include <variant>
 #include <unordered_map>
 #include <utility>
+#include <optional>
+#include <algorithm>
 
 
 #include "../Expr/Expr.hxx"
@@ -55,6 +57,14 @@ struct Value : VariantType {
 using ValuePtr = std::shared_ptr<Value>;
 
 
+// index of `T` among the alternatives of a Value
+template <typename T, size_t I = 0>
+[[nodiscard]] consteval size_t alternativeOf() {
+    if constexpr (std::is_same_v<std::variant_alternative_t<I, VariantType>, T>) return I;
+    else return alternativeOf<T, I + 1>();
+}
+
+
 std::string stringify(const Value& value, const size_t indent = {});
 [[nodiscard]] bool operator==(const Value& lhs, const Value& rhs) noexcept;
 }
@@ -68,8 +78,59 @@ struct std::hash<Value> { size_t operator()(const pie::value::Value& value) cons
 inline namespace pie {
 inline namespace value {
 
-struct Fields   { std::vector<std::tuple<expr::Name, type::TypePtr, expr::ExprPtr  >> fields;  };
-struct Members  { std::vector<std::tuple<expr::Name, type::TypePtr, value::ValuePtr>> members; };
+// maps member names to their slot in `Members::members`
+// every object built from the same class shares the same shape, so a shape pointer is enough to know the layout
+struct Shape {
+    std::unordered_map<std::string, size_t> slots;
+
+    template <typename Range>
+    [[nodiscard]] static ShapePtr of(const Range& entries) {
+        auto shape = std::make_shared<Shape>();
+        shape->slots.reserve(std::size(entries));
+
+        // emplace keeps the first occurrence, same as a linear search would
+        for (size_t i{}; const auto& entry : entries) shape->slots.emplace(get<expr::Name>(entry).name, i++);
+
+        return shape;
+    }
+
+    [[nodiscard]] std::optional<size_t> slot(const std::string& name) const {
+        if (const auto it = slots.find(name); it != slots.cend()) return it->second;
+        return {};
+    }
+};
+
+
+struct Fields {
+    std::vector<std::tuple<expr::Name, type::TypePtr, expr::ExprPtr>> fields;
+    mutable ShapePtr layout; // computed on first construction
+
+    // validated type and value of every default that is a plain literal, filled in by the interpreter on first construction
+    mutable std::vector<std::optional<std::pair<type::TypePtr, Value>>> constants;
+    mutable bool constants_ready{};
+
+    [[nodiscard]] const ShapePtr& shape() const {
+        if (not layout) layout = Shape::of(fields);
+        return layout;
+    }
+};
+
+struct Members {
+    std::vector<std::tuple<expr::Name, type::TypePtr, value::ValuePtr>> members;
+    ShapePtr shape; // may be null while the object is being built
+
+    std::shared_ptr<void> native{}; // whatever a builtin's object holds on to (the file behind a line reader). Goes with the object
+
+    [[nodiscard]] std::optional<size_t> slot(const std::string& name) const {
+        if (shape) return shape->slot(name);
+
+        const auto found = std::ranges::find_if(members, [&name] (const auto& member) { return get<expr::Name>(member).name == name; });
+        if (found == members.cend()) return {};
+
+        return found - members.cbegin();
+    }
+};
+
 struct Elements { std::vector<Value> values;                                                   };
 struct Items    { std::unordered_map<Value, Value> map;                                        };
 
@@ -92,9 +92,10 @@ inline bool validNameChar(const char c) noexcept {
     return isalnum(c);
 }
 
-[[nodiscard]] inline Tokens lex(const std::string& src) {
-    TokenLines lines = {{}};
-    Tokens line;
+// lexes into `tokens`, reusing whatever capacity it already has (the REPL hands back the previous line's buffer)
+inline void lex(const std::string_view src, Tokens& tokens) {
+    tokens.clear();
+    tokens.reserve(src.length() / 4); // rough guess. Most tokens are short
 
     size_t line_count = 1;
     size_t line_starting_index{};
@@ -119,7 +120,7 @@ inline bool validNameChar(const char c) noexcept {
                 bool is_name = validNameChar(src[index]);
                 if (is_name) {
                     while (validNameChar(src.at(++index)));
-                    lines.back().emplace_back(NAME, src.substr(beginning, index - beginning));
+                    tokens.emplace_back(NAME, std::string{src.substr(beginning, index - beginning)});
                     --index;
                     break;
                 }
@@ -130,7 +131,7 @@ inline bool validNameChar(const char c) noexcept {
                     while (isdigit(src.at(++index)));
                 }
 
-                lines.back().emplace_back(is_float ? FLOAT : INT, src.substr(beginning, index - beginning));
+                tokens.emplace_back(is_float ? FLOAT : INT, std::string{src.substr(beginning, index - beginning)});
                 --index;
             } break;
 
@@ -175,13 +176,13 @@ inline bool validNameChar(const char c) noexcept {
                     for (size_t ind = line_starting_index; ind < src.size() and src[ind] != '\n'; ++ind)
                         line_text += src[ind];
 
-                    lines.back().push_back({STRING, line_text});
+                    tokens.push_back({STRING, line_text});
                     --index;
                     break;
                 }
 
                 if (word == "__LINE__") [[unlikely]] {
-                    lines.back().push_back({INT, std::to_string(line_count)});
+                    tokens.push_back({INT, std::to_string(line_count)});
                     --index;
                     break;
                 }
@@ -189,22 +190,22 @@ inline bool validNameChar(const char c) noexcept {
 
                 const TokenKind token = keyword(word);
 
-                lines.back().emplace_back(token, word);
+                tokens.emplace_back(token, std::string{word});
                 --index;
             } break;
 
 
             case '=':
                 if (src.at(index + 1) == '>')
-                    lines.back().push_back({FAT_ARROW, {src[index], src[++index]}});
+                    tokens.push_back({FAT_ARROW, {src[index], src[++index]}});
                 else if ((src[index + 1] == '='))
-                    lines.back().push_back({NAME, {src[index], src[++index]}});
+                    tokens.push_back({NAME, {src[index], src[++index]}});
                 else
-                    lines.back().push_back({ASSIGN, {src[index]}});
+                    tokens.push_back({ASSIGN, {src[index]}});
 
                 break;
 
-            case ',': lines.back().push_back({COMMA, {src[index]}}); break;
+            case ',': tokens.push_back({COMMA, {src[index]}}); break;
             case '.':
                 if (src.at(index + 1) == ':') {
                     if (src.at(index + 2) == ':') {
@@ -219,23 +220,22 @@ inline bool validNameChar(const char c) noexcept {
                     else while(++index < src.length() and src[index] != '\n');
                 }
                 else if (src[index + 1] == '.' and src.at(index + 2) == '.')
-                    lines.back().push_back({ELLIPSIS, {src[index], src[++index], src[++index]}});
+                    tokens.push_back({ELLIPSIS, {src[index], src[++index], src[++index]}});
                 else if (src[index + 1] == '.')
-                    lines.back().push_back({CASCADE , {src[index], src[++index],             }});
+                    tokens.push_back({CASCADE , {src[index], src[++index],             }});
                 else
-                    lines.back().push_back({DOT, {src[index]}});
+                    tokens.push_back({DOT, {src[index]}});
 
                 break;
 
             case ':': 
-                if (src.at(index + 1) == ':') lines.back().push_back({SCOPE_RESOLVE, {':', src[++index]}});
-                else                          lines.back().push_back({COLON, ":"});
+                if (src.at(index + 1) == ':') tokens.push_back({SCOPE_RESOLVE, {':', src[++index]}});
+                else                          tokens.push_back({COLON, ":"});
 
                 break;
 
             case ';':
-                lines.back().push_back({SEMI, {src[index]}});
-                lines.push_back({});
+                tokens.push_back({SEMI, {src[index]}});
                 break;
 
             // case '\n': lines.back().clear(); break;
@@ -244,22 +244,22 @@ inline bool validNameChar(const char c) noexcept {
                 line_starting_index = index + 1;
                 break;
 
-            case '(': lines.back().push_back({L_PAREN, {src[index]}}); break;
-            case ')': lines.back().push_back({R_PAREN, {src[index]}}); break;
+            case '(': tokens.push_back({L_PAREN, {src[index]}}); break;
+            case ')': tokens.push_back({R_PAREN, {src[index]}}); break;
 
             case '{':
-                lines.back().push_back({L_BRACE, {src[index]}});
+                tokens.push_back({L_BRACE, {src[index]}});
                 // lines.push_back({});
                 break;
 
-            case '}': lines.back().push_back({R_BRACE, {src[index]}}); break;
+            case '}': tokens.push_back({R_BRACE, {src[index]}}); break;
 
             case '"':{
                 const size_t old = index;
                 while(src.at(++index) != '"') {
                     // if (src[index] == '\\')
                 }
-                lines.back().push_back({STRING, src.substr(old + 1, index - old -1)});
+                tokens.push_back({STRING, std::string{src.substr(old + 1, index - old -1)}});
             } break;
 
 
@@ -277,20 +277,17 @@ inline bool validNameChar(const char c) noexcept {
 
     }
 
-    if (not lines.empty() and not lines.back().empty() and lines.back().back().kind != TokenKind::SEMI)
-        util::error("Last line doesn't end with a ';'!");
+    if (tokens.empty()) return;
 
+    if (tokens.back().kind != TokenKind::SEMI) util::error("Last line doesn't end with a ';'!");
 
-    if (lines.size() > 1) {
-        lines.pop_back();
-        lines.back().emplace_back(TokenKind::END, "EOF");
-    }
+    tokens.emplace_back(TokenKind::END, "EOF");
+}
 
 
+[[nodiscard]] inline Tokens lex(const std::string_view src) {
     Tokens tokens;
-    for (auto&& line : lines)
-        for (auto&& t : line)
-            tokens.push_back(std::move(t));
+    lex(src, tokens);
 
     return tokens;
 }
@@ -7,6 +7,7 @@
 #include <vector>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <deque>
 #include <algorithm>
 #include <iterator>
@@ -18,6 +19,8 @@
 #include "../Expr/Expr.hxx"
 #include "../Parser/Precedence.hxx"
 #include "../Utils/utils.hxx"
+#include "../Utils/Arena.hxx"
+#include "../Utils/Module.hxx"
 
 
 inline namespace pie {
@@ -36,6 +39,12 @@ class Parser {
     std::deque<Token> red; // past tense of read lol
 
     std::filesystem::path root;
+    std::unordered_set<std::string> imported; // a module spliced in once isn't spliced in again
+    std::unordered_set<std::string> published; // operators already handed out by `parse`
+
+    // every node made by the current `parse` lives in here. Each batch of tokens gets its own,
+    // so a long-lived parser (the REPL's) doesn't keep every line it ever parsed around
+    util::ArenaPtr arena = util::Arena::make();
 
 
     enum class Context {
@@ -47,27 +56,51 @@ class Parser {
 
 public:
 
-    Parser(Tokens t, std::filesystem::path r = ".") noexcept
-    : tokens{std::move(t)}, token_iterator{tokens.begin()}, root{r.remove_filename()}
-    {}
+    Parser(Tokens t, std::filesystem::path r = ".")
+    : tokens{std::move(t)}, token_iterator{tokens.begin()}, root{std::filesystem::path{r}.remove_filename()}
+    { markImported(r); }
+
+
+    explicit Parser(std::filesystem::path r) : root{std::filesystem::path{r}.remove_filename()} { markImported(r); }
 
 
-    explicit Parser(std::filesystem::path r) noexcept : root{r.remove_filename()} {}
+    // so a module importing the file that imported it doesn't paste that file in a second time
+    void markImported(std::filesystem::path file) {
+        file.replace_extension(".pie");
+
+        std::error_code ec;
+        if (const auto canonical = std::filesystem::canonical(file, ec); not ec) imported.insert(canonical.string());
+    }
+
+
+    // one bump allocation in the arena for the node and its control block, instead of a malloc
+    template <typename T, typename... Args>
+    [[nodiscard]] std::shared_ptr<T> make(Args&&... args) {
+        return std::allocate_shared<T>(util::ArenaAllocator<T>{arena.get()}, std::forward<Args>(args)...);
+    }
 
 
     [[nodiscard]] bool atEnd(size_t offset = 0) const noexcept { return std::next(token_iterator, offset) == tokens.end() or std::next(token_iterator, offset)->kind == TokenKind::END; }
 
 
-    std::pair<std::vector<expr::ExprPtr>, Operators> parse(Tokens t = {}) {
+    // swapping hands the previous token buffer back to the caller so it can be lexed into again
+    std::pair<std::vector<expr::ExprPtr>, Operators> parse(Tokens&& t = {}) {
         if (not t.empty()) {
-            tokens = std::move(t);
+            tokens.swap(t);
             token_iterator = tokens.begin();
             red.clear();
+
+            arena = util::Arena::make(); // the last batch's goes once its nodes are gone
         }
 
         std::vector<expr::ExprPtr> expressions;
 
         while (not atEnd()) {
+            if (check(TokenKind::IMPORT)) {
+                spliceImport();
+                continue;
+            }
+
             expressions.push_back(parseExpr());
 
             // consume(TokenKind::SEMI);
@@ -85,12 +118,34 @@ public:
         }
 
 
+        // only the operators this call introduced. Whoever keeps parsing with the same parser already has the rest
         Operators os;
-        for (const auto& [name, op] : ops) os[name] = op->clone();
+        for (const auto& [name, op] : ops)
+            if (published.insert(name).second) os[name] = op->clone();
 
         return {expressions, std::move(os)};
     }
 
+    // a top level `import name;` pastes the module's tokens in its place,
+    // so everything it defines (operators included) is visible to the rest of the file
+    void spliceImport() {
+        consume(TokenKind::IMPORT);
+        auto path = root;
+        path.append(consume(TokenKind::NAME).text);
+        consume(TokenKind::SEMI);
+
+        const Tokens& module = modules::load(path);
+        if (not imported.insert(modules::canonicalName(path)).second) return;
+
+        // anything looked ahead past the `;` is still in `red` and would end up in front of the module.
+        // those are untouched copies of the tokens right before the iterator, so just step back over them
+        token_iterator -= static_cast<std::ptrdiff_t>(red.size());
+        red.clear();
+
+        token_iterator = tokens.insert(token_iterator, module.begin(), std::prev(module.end())); // without END
+    }
+
+
     template <bool PARSE_TYPE = true, Context CTX = Context::NONE>
     expr::ExprPtr parseExpr(const int precedence = 0) {
 
@@ -110,12 +165,12 @@ public:
             using enum TokenKind;
 
             case FLOAT :
-            case INT   : return std::make_shared<expr::Num   >(std::move(token).text);
-            case BOOL  : return std::make_shared<expr::Bool  >(token.text == "true" ? true : false);
-            case STRING: return std::make_shared<expr::String>(std::move(token).text);
+            case INT   : return make<expr::Num   >(std::move(token).text);
+            case BOOL  : return make<expr::Bool  >(token.text == "true" ? true : false);
+            case STRING: return make<expr::String>(std::move(token).text);
 
             case NAME:
-                if constexpr (not PARSE_TYPE) return std::make_shared<expr::Name>(std::move(token).text);
+                if constexpr (not PARSE_TYPE) return make<expr::Name>(std::move(token).text);
                 return prefixName(std::move(token));
 
             case CLASS: return klass();
@@ -124,18 +179,18 @@ public:
             case LOOP:  return loop ();
 
             case BREAK: 
-                // if (check(SEMI)) return std::make_shared<expr::Break>();
-                return std::make_shared<expr::Break>(parseExpr());
-                // if (check(SEMI)) return std::make_shared<expr::Break>(           );
-                // else             return std::make_shared<expr::Break>(parseExpr());
+                // if (check(SEMI)) return make<expr::Break>();
+                return make<expr::Break>(parseExpr());
+                // if (check(SEMI)) return make<expr::Break>(           );
+                // else             return make<expr::Break>(parseExpr());
 
             case CONTINUE:
                 // if (check(SEMI))
-                return std::make_shared<expr::Continue>();
-                // return std::make_shared<expr::Continue>(parseExpr());
+                return make<expr::Continue>();
+                // return make<expr::Continue>(parseExpr());
 
-                // if (check(SEMI)) return std::make_shared<expr::Continue>(           );
-                // else             return std::make_shared<expr::Continue>(parseExpr());
+                // if (check(SEMI)) return make<expr::Continue>(           );
+                // else             return make<expr::Continue>(parseExpr());
 
             case NAMESPACE: return nameSpace();
             case USE: {
@@ -149,10 +204,10 @@ public:
                     std::string name = spaces.back();
                     spaces.pop_back();
 
-                    return std::make_shared<expr::Use     >(global_access, std::move(spaces), std::move(name));
+                    return make<expr::Use     >(global_access, std::move(spaces), std::move(name));
                 }
                 else
-                    return std::make_shared<expr::UseSpace>(global_access, std::move(spaces));
+                    return make<expr::UseSpace>(global_access, std::move(spaces));
             }
 
 
@@ -161,7 +216,7 @@ public:
                 path.append(consume(NAME).text);
 
                 // path.replace_extension(".pie");
-                return std::make_shared<expr::Import>(std::move(path));
+                return make<expr::Import>(std::move(path));
             }
 
             // global namespace
@@ -174,10 +229,10 @@ public:
                 std::string name = std::move(spaces).back();
                 spaces.pop_back();
 
-                return std::make_shared<expr::SpaceAccess>(is_global_access, std::move(spaces), std::move(name));
+                return make<expr::SpaceAccess>(is_global_access, std::move(spaces), std::move(name));
             }
 
-            case COLON: return std::make_shared<expr::Type>(parseType());
+            case COLON: return make<expr::Type>(parseType());
 
             case MIXFIX:
             case PREFIX:
@@ -188,11 +243,11 @@ public:
 
             // block (scope) or list literal or map literal
             case L_BRACE: {
-                if (match(R_BRACE)) return std::make_shared<expr::List>();
+                if (match(R_BRACE)) return make<expr::List>();
 
                 if (match(COLON)) {
                     consume(R_BRACE);
-                    return std::make_shared<expr::Map>();
+                    return make<expr::Map>();
                 }
 
                 const bool map_expr = [this] {
@@ -247,7 +302,7 @@ public:
 
                     consume(R_BRACE);
 
-                    return std::make_shared<expr::Map>(std::move(exprs));
+                    return make<expr::Map>(std::move(exprs));
                 }
 
                 std::vector<expr::ExprPtr> exprs = { parseExpr(), };
@@ -257,14 +312,14 @@ public:
                         exprs.emplace_back(parseExpr());
                         consume(SEMI);
                     }
-                    return std::make_shared<expr::Block>(std::move(exprs));
+                    return make<expr::Block>(std::move(exprs));
                 }
                 else { // list literals
                     while (match(COMMA)) exprs.emplace_back(parseExpr()); 
 
                     consume(R_BRACE);
 
-                    return std::make_shared<expr::List>(std::move(exprs));
+                    return make<expr::List>(std::move(exprs));
                 }
 
                 util::error();
@@ -278,7 +333,7 @@ public:
                     consume(FAT_ARROW);
                     // It's a closure
                     auto body = parseExpr<PARSE_TYPE>();
-                    return std::make_shared<expr::Closure>(std::vector<std::string>{}, std::move(body), type::FuncType{{}, std::move(return_type)});
+                    return make<expr::Closure>(std::vector<std::string>{}, std::move(body), type::FuncType{{}, std::move(return_type)});
                 }
 
                 // todo: fix this algorithm
@@ -318,7 +373,7 @@ public:
                 // just a grouping `(x)`
                 auto expr = parseExpr();
                 consume(R_PAREN);
-                return std::make_shared<expr::Grouping>(std::move(expr));
+                return make<expr::Grouping>(std::move(expr));
                 // return expr;
             }
 
@@ -344,7 +399,7 @@ public:
                 auto accessee_ptr = dynamic_cast<expr::Name*>(accessee.get());
                 if (not accessee_ptr) util::error("Can only follow a '.' with a name: " + accessee->stringify());
 
-                return std::make_shared<expr::Access>(std::move(left), std::move(accessee_ptr)->name);
+                return make<expr::Access>(std::move(left), std::move(accessee_ptr)->name);
             }
 
 
@@ -361,7 +416,7 @@ public:
                 // // auto accessee_ptr = dynamic_cast<expr::Name*>(accessee.get());
                 // // if (not accessee_ptr) util::error("Can only follow a '.' with a name: " + accessee->stringify());
 
-                // return std::make_shared<expr::Access>(std::move(left), std::move(accessee_ptr)->name);
+                // return make<expr::Access>(std::move(left), std::move(accessee_ptr)->name);
             }
             [[fallthrough]];
 
@@ -380,14 +435,14 @@ public:
                 std::string name = std::move(spaces).back();
                 spaces.pop_back();
 
-                return std::make_shared<expr::SpaceAccess>(is_global_access, std::move(spaces), std::move(name));
+                return make<expr::SpaceAccess>(is_global_access, std::move(spaces), std::move(name));
             }
 
             case COLON: {
                 auto type = parseType();
                 if (not match(ASSIGN)) util::error();
 
-                return std::make_shared<expr::Assignment>(
+                return make<expr::Assignment>(
                     std::move(left),
                     std::move(type),
                     parseExpr(prec::ASSIGNMENT_VALUE - 1)
@@ -399,7 +454,7 @@ public:
             case ASSIGN:
                 if constexpr (CTX == Context::MATCH) return left;
 
-                return std::make_shared<expr::Assignment>(
+                return make<expr::Assignment>(
                     std::move(left),
                     type::builtins::_(),
                     parseExpr(prec::ASSIGNMENT_VALUE - 1)
@@ -424,7 +479,7 @@ public:
         if (match(ELLIPSIS)) {
             if constexpr (not ALLOW_VARIADIC) util::error("Can't have a variadic of a variadic type!");
 
-            return std::make_shared<type::VariadicType>(parseType<false>());
+            return make<type::VariadicType>(parseType<false>());
         }
 
         // either a function type
@@ -433,7 +488,7 @@ public:
                 consume(L_PAREN);
                 consume(R_PAREN);
                 consume(COLON);
-                return std::make_shared<type::FuncType>(std::vector<type::TypePtr>{}, parseType());
+                return make<type::FuncType>(std::vector<type::TypePtr>{}, parseType());
             }
 
             const bool func_type = [this] {
@@ -471,11 +526,11 @@ public:
                 consume(COLON);
 
                 type.ret = parseType();
-                return std::make_shared<type::FuncType>(std::move(type));
+                return make<type::FuncType>(std::move(type));
             }
 
             // just a grouping at this point, which means it's an expression
-            return std::make_shared<type::ExprType>(parseExpr());
+            return make<type::ExprType>(parseExpr());
         }
 
         if (match(L_BRACE)) { // list or map type
@@ -483,13 +538,13 @@ public:
 
 
             auto type1 = parseType<NO_VARIADICS>();
-            if (match(R_BRACE)) return std::make_shared<type::ListType>(std::move(type1));
+            if (match(R_BRACE)) return make<type::ListType>(std::move(type1));
 
             consume(COLON);
             auto type2 = parseType<NO_VARIADICS>();
             consume(R_BRACE);
 
-            return std::make_shared<type::MapType>(std::move(type1), std::move(type2));
+            return make<type::MapType>(std::move(type1), std::move(type2));
         }
 
 
@@ -504,7 +559,7 @@ public:
         }
 
         // or an expression
-        return std::make_shared<type::ExprType>(parseExpr<false>(prec::ASSIGNMENT_VALUE));
+        return make<type::ExprType>(parseExpr<false>(prec::ASSIGNMENT_VALUE));
     }
 
     std::unique_ptr<expr::Match::Case::Pattern> parsePattern() {
@@ -620,7 +675,7 @@ public:
         }
         while (not match(R_BRACE));
 
-        return std::make_shared<expr::Match>(std::move(expr), std::move(cases));
+        return make<expr::Match>(std::move(expr), std::move(cases));
     }
 
     expr::ExprPtr klass() {
@@ -652,7 +707,7 @@ public:
                 fields.push_back({expr::Name{ass->lhs->stringify()}, std::move(ass)->type , std::move(ass)->rhs});
         }
 
-        return std::make_shared<expr::Class>(std::move(fields));
+        return make<expr::Class>(std::move(fields));
     }
 
 
@@ -664,7 +719,7 @@ public:
         std::vector<type::TypePtr> types;
 
         // empty union
-        if (match(R_BRACE)) [[unlikely]] return std::make_shared<expr::Union>(std::move(types));
+        if (match(R_BRACE)) [[unlikely]] return make<expr::Union>(std::move(types));
 
         types.push_back(parseType());
         consume(SEMI);
@@ -674,7 +729,7 @@ public:
             consume(SEMI);
         }
 
-        return std::make_shared<expr::Union>(std::move(types));
+        return make<expr::Union>(std::move(types));
     }
 
     expr::ExprPtr nameSpace() {
@@ -691,7 +746,7 @@ public:
             consume(SEMI);
         }
 
-        return std::make_shared<expr::Namespace>(std::move(name), std::move(space));
+        return make<expr::Namespace>(std::move(name), std::move(space));
     }
 
 
@@ -739,14 +794,14 @@ public:
 
         if (match(ELLIPSIS)) {
             // left unary fold (unseparated) | case 3
-            if (match(R_PAREN))  return std::make_shared<expr::UnaryFold>(std::move(pack), std::move(op), l2r);
+            if (match(R_PAREN))  return make<expr::UnaryFold>(std::move(pack), std::move(op), l2r);
 
             consume(op);
 
             auto rhs = parseExpr(prec::HIGH_VALUE);
 
             // separated unary  | cases 4 and 5
-            if (match(R_PAREN)) return std::make_shared<expr::SeparatedUnaryFold>(std::move(pack), std::move(rhs), std::move(op));
+            if (match(R_PAREN)) return make<expr::SeparatedUnaryFold>(std::move(pack), std::move(rhs), std::move(op));
 
             consume(op);
 
@@ -756,7 +811,7 @@ public:
             auto init = parseExpr(prec::HIGH_VALUE);
 
             consume(R_PAREN);
-            return std::make_shared<expr::BinaryFold>(std::move(pack), std::move(init), std::move(op), r2l, std::move(separator));
+            return make<expr::BinaryFold>(std::move(pack), std::move(init), std::move(op), r2l, std::move(separator));
         }
 
 
@@ -777,7 +832,7 @@ public:
         consume(R_PAREN);
 
         // case 7 and 8
-        return std::make_shared<expr::BinaryFold>(std::move(pack), std::move(init), std::move(op), l2r, std::move(seperator));
+        return make<expr::BinaryFold>(std::move(pack), std::move(init), std::move(op), l2r, std::move(seperator));
     }
 
 
@@ -793,14 +848,14 @@ public:
         auto pack = parseExpr(prec::HIGH_VALUE);
 
         // unary fold | case 1
-        if (match(R_PAREN)) return std::make_shared<expr::UnaryFold>(std::move(pack), std::move(op), is_left_to_right);
+        if (match(R_PAREN)) return make<expr::UnaryFold>(std::move(pack), std::move(op), is_left_to_right);
 
         // binary fold | case 2
         consume(op);
         auto init = parseExpr(prec::HIGH_VALUE);
         consume(R_PAREN);
 
-        return std::make_shared<expr::BinaryFold>(std::move(pack), std::move(init), std::move(op), is_left_to_right);
+        return make<expr::BinaryFold>(std::move(pack), std::move(init), std::move(op), is_left_to_right);
     }
 
 
@@ -814,19 +869,19 @@ public:
         auto var_or_body = parseExpr();
 
         if (match(FAT_ARROW))
-            return std::make_shared<expr::Loop>(std::move(var_or_body), "", std::move(kind), parseExpr());
+            return make<expr::Loop>(std::move(var_or_body), "", std::move(kind), parseExpr());
 
         if (check(SEMI))
-            return std::make_shared<expr::Loop>(std::move(var_or_body), "", std::move(kind));
+            return make<expr::Loop>(std::move(var_or_body), "", std::move(kind));
 
 
         auto& var = var_or_body;
         auto body = parseExpr();
 
         if (match(FAT_ARROW))
-            return std::make_shared<expr::Loop>(std::move(body), std::move(var)->stringify(), std::move(kind), parseExpr());
+            return make<expr::Loop>(std::move(body), std::move(var)->stringify(), std::move(kind), parseExpr());
 
-        return std::make_shared<expr::Loop>(std::move(body), std::move(var)->stringify(), std::move(kind));
+        return make<expr::Loop>(std::move(body), std::move(var)->stringify(), std::move(kind));
     }
 
 
@@ -870,7 +925,7 @@ public:
         consume(FAT_ARROW);
 
         auto body = parseExpr();
-        return std::make_shared<expr::Closure>(
+        return make<expr::Closure>(
             std::move(params), std::move(body), type::FuncType{std::move(params_types), std::move(return_type)}
         );
     }
@@ -901,10 +956,10 @@ public:
                 }
 
                 else if (match(ELLIPSIS)) {
-                    arg = std::make_shared<expr::Expansion>(std::move(arg));
+                    arg = make<expr::Expansion>(std::move(arg));
 
                     while(match(ELLIPSIS)) // allows back to back expansions (args... ...);
-                        arg = std::make_shared<expr::Expansion>(std::move(arg));
+                        arg = make<expr::Expansion>(std::move(arg));
 
 
                     args.emplace_back(std::move(arg));
@@ -916,7 +971,7 @@ public:
             consume(R_PAREN);
         }
 
-        return std::make_shared<expr::Call>(std::move(left), std::move(named_args), std::move(args));
+        return make<expr::Call>(std::move(left), std::move(named_args), std::move(args));
     }
 
 
@@ -931,14 +986,14 @@ public:
 
             consume(TokenKind::ASSIGN);
 
-            return std::make_shared<expr::Assignment>(
-                std::make_shared<expr::Name>(std::move(token).text),
+            return make<expr::Assignment>(
+                make<expr::Name>(std::move(token).text),
                 std::move(type),
                 parseExpr()
             );
         }
 
-        return std::make_shared<expr::Name>(std::move(token).text);
+        return make<expr::Name>(std::move(token).text);
     }
 
 
@@ -946,13 +1001,13 @@ public:
         if (ops.contains(token.text)) {
             switch (const auto& op = ops[token.text]; op->type()) {
                 // case TokenKind::PREFIX:
-                //     return std::make_shared<UnaryOp>(token, parseExpr(precFromToken(op->prec)));
+                //     return make<UnaryOp>(token, parseExpr(precFromToken(op->prec)));
                 case TokenKind::INFIX: {
                     const auto prec = prec::calculate(op->high, op->low, ops);
-                    return std::make_shared<expr::BinOp>(std::move(left), std::move(token).text, parseExpr(prec));
+                    return make<expr::BinOp>(std::move(left), std::move(token).text, parseExpr(prec));
                 }
                 case TokenKind::SUFFIX:
-                    return std::make_shared<expr::PostOp>(std::move(token).text, std::move(left));
+                    return make<expr::PostOp>(std::move(token).text, std::move(left));
 
 
                 //* I can fix this. Check if the name is the first or not and error accordingly!
@@ -992,27 +1047,27 @@ public:
                     }
 
 
-                    return std::make_shared<expr::OpCall>(op->name, op->rest, std::move(exprs), op->op_pos);
+                    return make<expr::OpCall>(op->name, op->rest, std::move(exprs), op->op_pos);
                 }
 
                 default: util::error("prefix operator used as [inf/suf]fix");
             }
         }
 
-        return std::make_shared<expr::Name>(std::move(token).text);
+        return make<expr::Name>(std::move(token).text);
     }
 
     expr::ExprPtr parseOperator(Token token) {
         switch (const auto& op = ops[token.text]; op->type()) {
             case TokenKind::PREFIX:{
                 const int prec = prec::calculate(op->high, op->low, ops);
-                return std::make_shared<expr::UnaryOp>(std::move(token).text, parseExpr(prec));
+                return make<expr::UnaryOp>(std::move(token).text, parseExpr(prec));
             }
 
             case TokenKind::EXFIX:{
                 const auto& op = dynamic_cast<const expr::Exfix*>(ops[token.text].get());
 
-                auto ret = std::make_shared<expr::CircumOp>(op->name, op->name2, parseExpr());
+                auto ret = make<expr::CircumOp>(op->name, op->name2, parseExpr());
 
                 if (not match(op->name2)) util::error("Exfix operator not closed!");
 
@@ -1035,7 +1090,7 @@ public:
                     else exprs.push_back(parseExpr(prec));
                 }
 
-                return std::make_shared<expr::OpCall>(
+                return make<expr::OpCall>(
                     op->name, op->rest, std::move(exprs), op->op_pos // op->begin_expr, op->end_expr
                 );
             }
@@ -1125,15 +1180,15 @@ public:
         std::shared_ptr<expr::Fix> p;
         if (token.kind == PREFIX) {
             if (c->params.size() != 1) util::error("Prefix operator must be assigned to a unary closure!");
-            p = std::make_shared<expr::Prefix>(name, std::move(high), std::move(low), shift, std::vector<expr::ExprPtr>{/*std::move(func)*/});
+            p = make<expr::Prefix>(name, std::move(high), std::move(low), shift, std::vector<expr::ExprPtr>{/*std::move(func)*/});
         }
         else if (token.kind == INFIX) {
             if (c->params.size() != 2) util::error("Infix operator must be assigned to a binary closure!");
-            p = std::make_shared<expr::Infix> (name, std::move(high), std::move(low), shift, std::vector<expr::ExprPtr>{/*std::move(func)*/});
+            p = make<expr::Infix> (name, std::move(high), std::move(low), shift, std::vector<expr::ExprPtr>{/*std::move(func)*/});
         }
         else /* if (token.kind == SUFFIX) */ {
             if (c->params.size() != 1) util::error("Suffix operator must be assigned to a unary closure!");
-            p = std::make_shared<expr::Suffix>(name, std::move(high), std::move(low), shift, std::vector<expr::ExprPtr>{/*std::move(func)*/});
+            p = make<expr::Suffix>(name, std::move(high), std::move(low), shift, std::vector<expr::ExprPtr>{/*std::move(func)*/});
         }
 
 
@@ -1160,7 +1215,7 @@ public:
         if (c->params.size() != 1) util::error("Exfix operator must be assigned to a unary closure!");
 
 
-        std::shared_ptr<expr::Fix> p = std::make_shared<expr::Exfix>(
+        std::shared_ptr<expr::Fix> p = make<expr::Exfix>(
             name1, name2, prec::LOW, prec::LOW, 0, std::vector<expr::ExprPtr>{/* std::move(func) */}
         );
 
@@ -1181,7 +1236,7 @@ public:
             }
 
 
-            return std::make_shared<expr::Exfix>(*ex);
+            return make<expr::Exfix>(*ex);
         }
 
         ops[name1] = p->clone();
@@ -1265,7 +1320,7 @@ public:
         }
 
         std::shared_ptr<expr::Fix> p =
-            std::make_shared<expr::Operator>(
+            make<expr::Operator>(
                 std::move(first),
                 rest, // how can I move it?
                 std::move(op_pos),
@@ -1294,7 +1349,7 @@ public:
 
             if (not same) util::error(); // ! ADD ERR MSG
 
-            return std::make_shared<expr::Operator>(*arb);
+            return make<expr::Operator>(*arb);
         }
 
         ops[p->name] = p->clone();
@@ -1,132 +1,133 @@
 #pragma once
 
 
-#include <print>
 #include <cctype>
 #include <string>
-#include <fstream>
+#include <string_view>
 #include <unordered_set>
 #include <filesystem>
-#include <ranges>
-#include <stdexcept>
+
+#include "../Utils/utils.hxx"
+#include "../Lex/Lexer.hxx"
 
 inline namespace pie {
 
-[[nodiscard]] inline std::string readFile2(const std::string& fname) {
-    const std::ifstream fin{fname};
 
-    if (not fin.is_open()) {
-        std::println(std::cerr, "{}", "File \"" + fname + " \"not found!");
-        throw std::runtime_error{"file '" + fname + "' not found!"};
-    }
+// * pre-processor * //
+// one pass over the source. Comments are dropped, strings are copied as they are,
+// and every `import name;` is replaced by the (already pre-processed) module, written straight into the same output.
+// so the whole thing is linear in the size of the output, no matter how many comments or imports there are
+class Preprocessor {
+    std::string out;
 
-    std::stringstream ss;
-    ss << fin.rdbuf();
+    std::unordered_set<std::string> done;   // modules already pasted somewhere
+    std::unordered_set<std::string> active; // modules being pasted right now. Importing one of those would never end
 
-    return ss.str();
-}
 
+    // everything up to `end` (exclusive), or the rest of the source if `end` isn't there
+    static size_t skipPast(const std::string_view src, const size_t from, const std::string_view end) noexcept {
+        const auto found = src.find(end, from);
+        return found == std::string_view::npos ? src.size() : found + end.size();
+    }
 
-bool findAndRemoveImport(std::string& src, size_t& index) {
-    using std::operator""sv;
-
-    index = src.find("import");
 
-    if (index == std::string::npos) return false;
+    void module(const std::string_view src, size_t& index, const std::filesystem::path& dir) {
+        while (index < src.size() and std::isspace(static_cast<unsigned char>(src[index]))) ++index;
 
-    constexpr size_t import_length = "import"sv.length();
+        const size_t start = index;
+        while (index < src.size() and not std::isspace(static_cast<unsigned char>(src[index])) and src[index] != ';') ++index;
 
-    src.erase(index, import_length);
+        const auto name = src.substr(start, index - start);
+        if (name.empty()) util::error("Expected a module name after 'import'!");
 
-    return true;
-}
+        if (index < src.size() and src[index] == ';') ++index;
 
-size_t findSpace(const std::string& src, size_t ind) {
-    while (++ind < src.length() and not std::isspace(src[ind]) and src[ind] != ';');
 
-    return ind;
-}
+        auto filename = dir / name;
+        filename.replace_extension(".pie");
 
+        std::error_code ec;
+        const auto path = std::filesystem::canonical(filename, ec);
+        if (ec) util::error("File \"" + filename.string() + " \" not found!");
 
-void removeBlockComments(std::string& s) {
-    for (size_t ind = s.find(".::"); ind != std::string::npos; ind = s.find(".::")) {
-        const size_t end_ind = s.find("::.", ind); // look for end starting from index "ind"
-        s.erase(ind, end_ind - ind + 3); // 3 == length("::.")
-    }
-}
+        const auto key = path.string();
+        if (done.contains(key) or active.contains(key)) return;
 
+        active.insert(key);
+        run(util::readFile(key), path);
+        active.erase(key);
 
-void removeLineComments(std::string& s) {
-    for (size_t ind = s.find(".:"); ind != std::string::npos; ind = s.find(".:")) {
-        const size_t end_ind = s.find("\n", ind); // look for end starting from index "ind"
-        s.erase(ind, end_ind - ind + 1); // 3 == length("\n")
+        done.insert(key);
     }
-}
-
-
-// needed so we don't process imports inside comments sections.
-std::string removeComments(std::string src) {
-    // removing block comments
-    // doing that first so that we don't confuse ".:" with ".::"
-    removeBlockComments(src);
-
-    removeLineComments(src);
-
-    return src;
-}
 
-template <bool = false>
-std::string preprocess(std::string src, const std::filesystem::path& root = ".");
 
-template <bool REPL = false>
-std::string process(std::string src, const std::filesystem::path& root) {
-    static std::unordered_set<std::string> cache;
+    void run(const std::string_view src, const std::filesystem::path& file) {
+        const auto dir = std::filesystem::path{file}.remove_filename();
 
-    auto canonical = std::filesystem::canonical(root);
+        for (size_t index{}; index < src.size();) {
+            const char c = src[index];
 
-    if constexpr (not REPL) {
-        if (cache.contains(canonical.string())) return "";
-        cache.insert(canonical.string());
-    }
+            // comments. Checking ".::" first so it's not confused with ".:"
+            if (c == '.' and src.substr(index, 3) == ".::") {
+                index = skipPast(src, index + 3, "::.");
+                continue;
+            }
 
+            if (c == '.' and src.substr(index, 2) == ".:") {
+                index = src.find('\n', index);
+                if (index == std::string_view::npos) index = src.size(); // the newline itself is kept
+                continue;
+            }
 
-    auto mainfile = root;
-    mainfile.remove_filename();
+            // strings are copied whole, so nothing inside of them looks like a comment or an import
+            if (c == '"') {
+                const size_t end = skipPast(src, index + 1, "\"");
+                out.append(src.substr(index, end - index));
+                index = end;
+                continue;
+            }
 
-    size_t index;
+            // whole words only, so `important` or `imports` are left alone
+            if (lex::validNameChar(c)) {
+                const size_t start = index;
+                while (index < src.size() and lex::validNameChar(src[index])) ++index;
 
-    while (findAndRemoveImport(src, index)) {
-        auto filename = mainfile;
+                const auto word = src.substr(start, index - start);
 
-        const auto end_index = findSpace(src, index);
+                if (word == "import") module(src, index, dir);
+                else out.append(word);
 
-        ++index;
-        auto name = src.substr(index, end_index - index);
-        src.erase(index, end_index - index + (src[end_index] == ';')); // remove filename
-        // std::ranges::replace(name, ':', '/');
+                continue;
+            }
 
-        filename /= name;
+            out.push_back(c);
+            ++index;
+        }
+    }
 
-        filename.replace_extension(".pie");
 
-        auto path = std::filesystem::canonical(filename);
-        // auto path = std::filesystem::absolute(filename);
+public:
+    [[nodiscard]] std::string process(const std::string_view src, const std::filesystem::path& root) {
+        out.clear();
+        out.reserve(src.size());
 
-        auto module = readFile2(path.string());
+        active.clear();
+        if (std::error_code ec; std::filesystem::is_regular_file(root, ec)) active.insert(std::filesystem::canonical(root, ec).string());
 
-        module = preprocess(std::move(module), std::move(path));
+        run(src, root);
 
-        src.insert(index, std::move(module));
+        return std::move(out);
     }
 
-    return src;
-}
+    // REPL lines are pre-processed one at a time, and each one may import the same module again
+    void forget() noexcept { done.clear(); }
+};
 
 
-template <bool REPL>
-std::string preprocess(std::string src, const std::filesystem::path& root) {
-    return process<REPL>(removeComments(std::move(src)), root);
+// a fresh one every time, so nothing pasted by one run is skipped in the next. The REPL keeps its own (see Session)
+inline std::string preprocess(const std::string_view src, const std::filesystem::path& root = ".") {
+    return Preprocessor{}.process(src, root);
 }
 
 
-} // namespace pie
\ No newline at end of file
+} // namespace pie
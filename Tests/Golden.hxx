@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <cstdlib>
+
+#include "TestSuite.hxx"
+#include "../Utils/Counters.hxx"
+
+
+inline namespace pie {
+namespace test {
+
+// * golden counts * //
+// every `name.pie` in Tests/Golden is run in counting mode and the counts are compared with `name.count` next to it.
+// a change that makes the interpreter do more work (not just take longer) shows up as a diff in there
+// run the tests with PIE_UPDATE_GOLDEN=1 to write the current counts instead (then review the diff!)
+
+inline const std::filesystem::path golden_dir = "Tests/Golden";
+
+
+[[nodiscard]] inline std::string counts(const std::string& src) {
+    util::counters() = std::make_unique<util::Counters>();
+
+    run(src.c_str());
+
+    std::ostringstream report;
+    util::counters()->report(report);
+    util::counters().reset();
+
+    return report.str();
+}
+
+
+struct Golden {
+    std::string expected, got;
+};
+
+[[nodiscard]] inline Golden golden(const std::filesystem::path& program) {
+    auto count_file = program;
+    count_file.replace_extension(".count");
+
+    Golden result{.expected = {}, .got = counts(util::readFile(program.string()))};
+
+    if (std::getenv("PIE_UPDATE_GOLDEN")) std::ofstream{count_file, std::ios::binary} << result.got;
+
+    if (std::filesystem::exists(count_file)) result.expected = util::readFile(count_file.string());
+
+    return result;
+}
+
+
+} // namespace test
+} // namespace pie
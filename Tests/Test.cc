@@ -2,7 +2,9 @@
 #include "catch.hpp"
 
 #include <stdexcept>
+#include <filesystem>
 #include "TestSuite.hxx"
+#include "Golden.hxx"
 
 #include "../Type/Type.hxx"
 
@@ -839,6 +841,29 @@ Object {
 }
 
 
+TEST_CASE("Narrowing To A Class", "[Class][Func]") {
+    const auto src = R"(
+print = __builtin_print;
+
+Point = class { x = 0; y = 0; };
+Point3 = class { z = 0; y = 0; x = 0; };
+
+flat = (p: Point) => p;
+
+p = flat(Point3(3, 2, 1));
+print(p);
+print(__builtin_add(p.x, p.y));
+)";
+
+    // laid out like the class it was narrowed to
+    REQUIRE(pie::test::run(src) == R"(Object {
+    x = 1;
+    y = 2;
+}
+3)");
+}
+
+
 TEST_CASE("Shaw's Shinanegans", "[Class]") {
     const auto src = R"(
 print = __builtin_print;
@@ -2208,6 +2233,90 @@ print(func(1, 2, 3, 4));
 
 
 
+TEST_CASE("Builtin overloads", "[Builtin]") {
+    const auto src1 = R"(
+print = __builtin_print;
+print(__builtin_add(1, 2), __builtin_add(1, 0.5), __builtin_mul(0.5, 4), __builtin_sub(2.5, 0.5));
+print(__builtin_eq(1, 1), __builtin_eq(1, "1"), __builtin_lt(1, 1.5), __builtin_len("four"));
+)";
+
+    REQUIRE(pie::test::run(src1) == "3 1.500000 2.000000 2.000000\ntrue false true 4");
+
+
+    const auto src2 = R"(__builtin_add(1, "two");)";
+
+    REQUIRE_THROWS_WITH(pie::test::run(src2), Catch::Matchers::ContainsSubstring("Wrong type passed to function: add"));
+}
+
+
+
+TEST_CASE("Print formatting", "[Builtin]") {
+    const auto src1 = R"(
+print = __builtin_print;
+print(1, 2.5, "three", false, sep = ", ", end = ";");
+print(__builtin_neg(7), end = "");
+)";
+
+    REQUIRE(pie::test::run(src1) == "1, 2.500000, three, false;-7");
+
+
+    // nothing printed by a program that blew up should leak into the next one
+    const auto src2 = R"(__builtin_print("before"); __builtin_add(1, "two");)";
+    REQUIRE_THROWS(pie::test::run(src2));
+
+    REQUIRE(pie::test::run(R"(__builtin_print("after");)") == "after");
+}
+
+
+
+TEST_CASE("File IO", "[Builtin]") {
+    const auto path = (std::filesystem::temp_directory_path() / "pie_file_io_test.txt").string();
+
+    const auto src = R"(
+print = __builtin_print;
+path = ")" + path + R"(";
+
+print(__builtin_write_file(path, "one
+two
+"));
+__builtin_append_file(path, "three");
+
+print(__builtin_len(__builtin_read_whole(path)));
+print(__builtin_read_file(path));
+
+loop __builtin_read_lines(path) => line print(line, end = "|");
+print("");
+
+lines = __builtin_read_lines(path);
+print(lines.next(), lines.hasNext());
+
+.: stopping early is fine, the file goes with the object
+loop __builtin_read_lines(path) => line { print(line); break 0; };
+)";
+
+    REQUIRE(pie::test::run(src.c_str()) == R"(8
+13
+{one, two, three}
+one|two|three|
+one true
+one)");
+
+
+    // readers are objects that own their file, not numbers that could point at someone else's
+    const auto forged = R"(
+lines = __builtin_read_lines(")" + path + R"(");
+__builtin_has_line(0);
+)";
+    REQUIRE_THROWS_AS(pie::test::run(forged.c_str()), pie::except::InvalidArgument);
+
+    std::filesystem::remove(path);
+
+
+    REQUIRE_THROWS(pie::test::run(R"(__builtin_read_whole("this file does not exist");)"));
+}
+
+
+
 TEST_CASE("literals", "[Assingment]") {
     const auto src = R"(
 print = __builtin_print;
@@ -2428,6 +2537,65 @@ print(x::v);
 
 
 
+TEST_CASE("Matching on literals and types", "[Match]") {
+    const auto src = R"(
+print = __builtin_print;
+Box = class { v = 0; };
+
+describe = (x) => match x {
+    = 1 => "one";
+    n: Int & __builtin_gt(n, 100) => "big";
+    : Int => "int";
+    = "hi" => "greeting";
+    s: String => s;
+    Box(= 1) => "box of one";
+    Box(v) => v;
+    : Double => "double";
+    _ => "other";
+};
+
+loop {1, 500, 7, "hi", "yo", Box(1), Box(9), 1.5, true} => x print(describe(x));
+)";
+
+    REQUIRE(pie::test::run(src) == R"(one
+big
+int
+greeting
+yo
+box of one
+9
+double
+other)");
+
+
+    // a value written as a literal in some case only tries that case and the ones that take any value of its kind, still in order
+    const auto src2 = R"(
+print = __builtin_print;
+
+name = (x) => match x {
+    n: Int & __builtin_gt(n, 9) => "many";
+    = 1 => "one";
+    = 2 => "two";
+    = 1 => "never";
+    : Int => "some";
+    = "a" => "letter a";
+    _ => "other";
+};
+
+loop {1, 2, 3, 10, "a", "b", 1.5} => x print(name(x));
+)";
+
+    REQUIRE(pie::test::run(src2) == R"(one
+two
+some
+many
+letter a
+other
+other)");
+}
+
+
+
 TEST_CASE("Trees", "[Match]") {
     const auto src = R"(
 print = __builtin_print;
@@ -2477,6 +2645,62 @@ print(result);
 
 
 
+TEST_CASE("Same access on different classes", "[Type]") {
+    const auto src = R"(
+print = __builtin_print;
+
+A = class { x = 1; y = 2; };
+B = class { y = 3; x = 4; };
+
+get_x = (o) => o.x;
+set_y = (o, v) => o.y = v;
+
+loop {A(), B(), A(10), B(30)} => obj {
+    set_y(obj, __builtin_add(get_x(obj), 100));
+    print(get_x(obj), obj.y);
+};
+)";
+
+    REQUIRE(pie::test::run(src) == R"(1 101
+4 104
+10 110
+4 104)");
+}
+
+
+
+TEST_CASE("Constant member defaults", "[Type]") {
+    const auto src1 = R"(
+print = __builtin_print;
+
+P = class { x = 1; s: String = "s"; b = true; };
+a = P();
+b = P(5);
+a.x = 2;
+print(a.x, a.s, a.b, b.x, P().x);
+)";
+
+    REQUIRE(pie::test::run(src1) == "2 s true 5 1");
+
+
+    const auto src2 = R"(
+P = class { x: Int = "not an int"; };
+p = P(1);
+)";
+
+    REQUIRE_NOTHROW(pie::test::run(src2));
+
+
+    const auto src3 = R"(
+P = class { x: Int = "not an int"; };
+p = P();
+)";
+
+    REQUIRE_THROWS_AS(pie::test::run(src3), pie::except::TypeMismatch);
+}
+
+
+
 TEST_CASE("Class member", "[Type]") {
     const auto src = R"(
 wow = class { inner = class { hmm = 1; }; };
@@ -2695,3 +2919,753 @@ print(add(g = 7, 1, c = 3, 2, 4, 5, f = 6, 1, "", 1.0));
     REQUIRE(pie::test::run(src1) == "0");
 }
 
+
+
+TEST_CASE("Imports", "[Import]") {
+    const pie::test::ScratchDir scratch{"pie_import_test"};
+    const auto write = [] (const char* name, const char* src) { std::ofstream{name} << src; };
+
+    write("pie_import_ops.pie", R"(
+print = __builtin_print;
+infix + = (a, b) => __builtin_add(a, b);
+)");
+
+    write("pie_import_main.pie", R"(
+import pie_import_ops;
+two = 1 + 1;
+)");
+
+    write("pie_import_square.pie", R"(
+(x) => __builtin_mul(x, x);
+)");
+
+
+    const auto src = R"(
+import pie_import_main;
+import pie_import_ops;
+
+print(two + 3);
+
+square = import pie_import_square;
+print(square(7));
+)";
+
+    REQUIRE(pie::test::run(src) == "5\n49");
+    REQUIRE(std::filesystem::exists("pie_import_ops.piec"));
+
+    // straight from the .piec files this time
+    pie::modules::table().clear();
+    REQUIRE(pie::test::run(src) == "5\n49");
+
+    // editing a module invalidates its cache
+    pie::modules::table().clear();
+    write("pie_import_square.pie", R"(
+(x) => __builtin_add(x, x);
+)");
+    REQUIRE(pie::test::run(src) == "5\n14");
+
+    // touching it without changing it keeps the cache, which picks up the new stamp
+    pie::modules::table().clear();
+    const auto touched = std::filesystem::file_time_type::clock::now() - std::chrono::hours{1};
+    std::filesystem::last_write_time("pie_import_square.pie", touched);
+    REQUIRE(pie::test::run(src) == "5\n14");
+
+    // from then on the source isn't even read as long as its size and time stay the same
+    pie::modules::table().clear();
+    write("pie_import_square.pie", R"(
+(x) => __builtin_mul(x, x);
+)");
+    std::filesystem::last_write_time("pie_import_square.pie", touched);
+    REQUIRE(pie::test::run(src) == "5\n14");
+
+    REQUIRE_THROWS(pie::test::run("import pie_import_does_not_exist;"));
+}
+
+
+TEST_CASE("Preprocessor", "[Import]") {
+    const pie::test::ScratchDir scratch{"pie_preprocess_test"};
+    std::ofstream{"pie_preprocess_module.pie"} << "y = 2; .: from the module\nimport pie_preprocess_module;\n";
+
+    const auto src = R"(x = 1; .: a comment with import in it
+.:: a block
+comment ::.
+important = ".: not a comment, import";
+import pie_preprocess_module;
+import pie_preprocess_module;
+)";
+
+    REQUIRE(pie::preprocess(src) == R"(x = 1; 
+
+important = ".: not a comment, import";
+y = 2; 
+
+
+
+)");
+
+    // every run starts over, so the module is pasted again
+    REQUIRE(pie::preprocess("import pie_preprocess_module;") == "y = 2; \n\n");
+
+    // and so does every line in a session
+    pie::Session session;
+    REQUIRE(session.preprocess("import pie_preprocess_module;") == "y = 2; \n\n");
+    REQUIRE(session.preprocess("import pie_preprocess_module;") == "y = 2; \n\n");
+}
+
+
+TEST_CASE("Preloading imports", "[Import]") {
+    const pie::test::ScratchDir scratch{"pie_preload_test"};
+    std::filesystem::create_directory("pie_preload_test");
+
+    std::ofstream{"pie_preload_test/a.pie"} << "import b; import c; a = __builtin_add(b, c);";
+    std::ofstream{"pie_preload_test/b.pie"} << "import c; b = __builtin_add(c, 1);";
+    std::ofstream{"pie_preload_test/c.pie"} << "c = 20;";
+
+    const auto src = "import pie_preload_test/a; __builtin_print(a);";
+
+    pie::modules::table().clear();
+    pie::modules::preload(lex::lex(src), "main.pie");
+
+    // the whole graph is loaded before any parsing happens
+    REQUIRE(pie::modules::table().size() == 3);
+    REQUIRE(pie::test::run(src) == "41");
+
+    // a broken module is skipped quietly by the workers and only reported once, when it's actually loaded
+    std::ofstream{"pie_preload_test/broken.pie"} << "d = 1";
+    const auto broken = "import pie_preload_test/broken;";
+
+    pie::modules::table().clear();
+    REQUIRE_NOTHROW(pie::modules::preload(lex::lex(broken), "main.pie"));
+    REQUIRE(pie::modules::table().empty());
+    REQUIRE_FALSE(pie::util::quiet_errors);
+    REQUIRE_THROWS(pie::test::run(broken));
+}
+
+
+TEST_CASE("REPL Session", "[Session]") {
+    pie::Session session;
+
+    const auto eval = [&session] (const char* src) { return pie::stringify(*session.eval(src)); };
+
+    REQUIRE_NOTHROW(eval("infix + = (a, b) => __builtin_add(a, b);"));
+    REQUIRE(eval("x = 40;") == "40");
+    REQUIRE(eval("x + 2;") == "42");
+
+    // definitions from earlier snippets keep working, and new ones can use them
+    REQUIRE_NOTHROW(eval("f = (y) => x + y;"));
+    REQUIRE(eval("x = 1; f(1);") == "2");
+
+    REQUIRE_THROWS(session.eval("g(1);"));
+    REQUIRE(eval("f(2);") == "3"); // still usable after an error
+
+    REQUIRE_FALSE(session.eval("").has_value());
+
+
+    // a closure's body outlives the session that parsed it, and the arena it lives in
+    std::optional<pie::Value> id;
+    {
+        pie::Session other;
+        id = other.eval("(x) => __builtin_add(x, 1);");
+    }
+
+    REQUIRE(pie::stringify(*id).ends_with("=> __builtin_add(x, 1)"));
+}
+
+
+TEST_CASE("Profiler", "[Profile]") {
+    pie::util::profiler() = std::make_unique<pie::util::Profiler>(); // one sample per call, so the counts are exact
+
+    pie::test::run(R"(
+infix + = (a, b) => __builtin_add(a, b);
+double = (x) => x + x;
+double(1);
+double(2);
+three = 3;
+three = 3; .: assigned twice, so it's not a constant to fold
+three + 4;
+)");
+
+    std::ostringstream folded, table;
+    pie::util::profiler()->collapsed(folded);
+    pie::util::profiler()->table(table);
+    pie::util::profiler().reset();
+
+    REQUIRE(folded.str() == R"(main;+ 1
+main;+;__builtin_add 1
+main;double 2
+main;double;+ 2
+main;double;+;__builtin_add 2
+)");
+
+    REQUIRE(table.str().find("  __builtin_add") != std::string::npos);
+}
+
+
+TEST_CASE("Golden counts", "[Count]") {
+    size_t programs{};
+
+    for (const auto& entry : std::filesystem::directory_iterator{pie::test::golden_dir}) {
+        if (entry.path().extension() != ".pie") continue;
+        ++programs;
+
+        INFO(entry.path().string());
+        const auto [expected, got] = pie::test::golden(entry.path());
+        REQUIRE(got == expected);
+    }
+
+    REQUIRE(programs > 0);
+}
+
+
+TEST_CASE("Dependent Parameter Types", "[Func][Param][Type]") {
+    auto tokens = lex::lex("f = (T: Type, x: T, y: Int): T => x;");
+    pie::Parser p{std::move(tokens)};
+    auto [exprs, _] = p.parse();
+
+    pie::analysis::LexicalAnalysis anal;
+    for (const auto& expr : exprs) std::visit(anal, expr->variant());
+
+    const auto ass = std::dynamic_pointer_cast<pie::expr::Assignment>(exprs[0]);
+    REQUIRE(ass);
+    const auto closure = std::dynamic_pointer_cast<pie::expr::Closure>(ass->rhs);
+    REQUIRE(closure);
+    REQUIRE(closure->deps); // worked out by the analysis, not on the first call
+
+    constexpr auto none = pie::expr::Closure::Dependencies::none;
+    REQUIRE(closure->deps->params == std::vector<size_t>{none, 0, none});
+    REQUIRE(closure->deps->ret == 0);
+
+
+    const auto src1 = R"(
+print = __builtin_print;
+f = (T: Type, x: T, y: T): T => y;
+
+print(f(Int, 1, 2));
+print(f(1, 2, T = Int));
+)";
+
+    REQUIRE(pie::test::run(src1) == "2\n2");
+
+
+    const auto src2 = R"(
+f = (T: Type, x: T, y: T): T => y;
+
+f(1, "2", T = Int);
+)";
+
+    REQUIRE_THROWS_AS(pie::test::run(src2), pie::except::TypeMismatch);
+}
+
+
+TEST_CASE("Namespace Slots", "[Space]") {
+    const auto src = R"(
+space util {
+    space math { sq = (x) => __builtin_mul(x, x); };
+    f = (x) => util::math::sq(x);
+};
+
+space util {
+    space math { cube = (x) => __builtin_mul(x, util::math::sq(x)); };
+};
+)";
+
+    auto tokens = lex::lex(src);
+    pie::Parser p{std::move(tokens)};
+    auto [exprs, _] = p.parse();
+
+    pie::analysis::LexicalAnalysis anal;
+    for (const auto& expr : exprs) std::visit(anal, expr->variant());
+
+    // reopening a space lands in the same slot
+    const auto first  = std::dynamic_pointer_cast<pie::expr::Namespace>(exprs[0]);
+    const auto second = std::dynamic_pointer_cast<pie::expr::Namespace>(exprs[1]);
+    REQUIRE(first);
+    REQUIRE(second);
+    REQUIRE(first->slot >= 0);
+    REQUIRE(first->slot == second->slot);
+
+
+    REQUIRE(pie::test::run((std::string{src} + R"(
+print = __builtin_print;
+
+print(util::f(3));
+print(util::math::cube(2));
+print(::util::math::sq(4));
+
+use space util;
+print(math::sq(5));
+)").c_str()) == "9\n8\n16\n25");
+}
+
+
+TEST_CASE("Use Space Views", "[Space][Var]") {
+    const auto src1 = R"(
+print = __builtin_print;
+
+space lib {
+    n = 1;
+    inc = (y) => __builtin_add(y, 1);
+};
+
+f = (x) => {
+    use space lib;
+    __builtin_add(inc(x), n);
+};
+
+make = () => {
+    use space lib;
+    () => inc(n);
+};
+
+print(f(1));
+print(f(f(1)));
+
+g = make();
+print(g());
+
+lib::n = 5;
+print(f(1));
+print(g());
+)";
+
+    REQUIRE(pie::test::run(src1) == "3\n5\n2\n7\n6");
+
+
+    const auto src2 = R"(
+print = __builtin_print;
+
+space a { x = 1; };
+space b { use space a; };
+
+print(b::x);
+
+use space a;
+x = 7;
+print(a::x);
+)";
+
+    REQUIRE(pie::test::run(src2) == "1\n7");
+
+
+    // closures passed out of the frame that used the space still find its members, without copying them
+    const auto src3 = R"(
+print = __builtin_print;
+
+space lib { n = 1; };
+
+apply = (h) => h();
+p = () => {
+    use space lib;
+    apply(() => n);
+};
+
+print(p());
+lib::n = 2;
+print(p());
+)";
+
+    REQUIRE(pie::test::run(src3) == "1\n2");
+
+
+    // members used as types and as constructors in patterns are found the same way
+    const auto src4 = R"(
+print = __builtin_print;
+
+space lib {
+    n = 1;
+    get = () => n;
+    T = class { v = 0; };
+};
+
+use space lib;
+
+t: T = T(3);
+m = (x) => match x { T(v) => v; };
+
+print(t.v);
+print(m(T(9)));
+
+n = 4;
+print(lib::n);
+print(get());
+)";
+
+    REQUIRE(pie::test::run(src4) == "3\n9\n4\n4");
+}
+
+
+TEST_CASE("binary separated right fold", "[Fold Exprs]") {
+    const auto src = R"(
+print = __builtin_print;
+infix + = (a: Int, b: Int) => __builtin_add(a, b);
+infix + = (a: String, b: String) => __builtin_concat(a, b);
+
+list = (names: ...String) => (", " + ... + names + ".");
+print(list("a", "b", "c"));
+
+.: 2 overloads, so every step goes through overload resolution
+total = (xs: ...Int) => (... + xs + 0);
+print(total(1, 2, 3, 4, 5, 6, 7, 8, 9, 10));
+)";
+
+    REQUIRE(pie::test::run(src) == "a, b, c, .\n55");
+}
+
+
+TEST_CASE("Direct Builtin Operators", "[Operator][Builtin]") {
+    const auto src1 = R"(
+print = __builtin_print;
+infix     + = (a: Int, b: Int): Int => __builtin_add(a, b);
+infix(+ +) * = (a: Int, b: Int): Int => __builtin_mul(a, b);
+prefix - = (a: Int): Int => __builtin_neg(a);
+infix(+) ++ = (a: Int, b: Int): Int => __builtin_add(b, a);
+
+print(1 + 2 * 3);
+print(-(4 + 5));
+print(1 ++ 2);
+
+sum = (xs: ...Int) => (... + xs);
+print(sum(1, 2, 3, 4));
+)";
+
+    REQUIRE(pie::test::run(src1) == "7\n-9\n3\n10");
+
+
+    // the return type is still checked
+    const auto src2 = R"(
+infix + = (a: Int, b: Int): String => __builtin_add(a, b);
+1 + 2;
+)";
+
+    REQUIRE_THROWS_AS(pie::test::run(src2), pie::except::TypeMismatch);
+
+
+    auto tokens = lex::lex(src1);
+    pie::Parser p{std::move(tokens)};
+    auto [exprs, ops] = p.parse();
+
+    pie::analysis::LexicalAnalysis anal;
+    for (const auto& expr : exprs) std::visit(anal, expr->variant());
+
+    // the operators' closures live in their declarations, not in the table
+    const auto closure = [&exprs] (const size_t i) {
+        return dynamic_cast<pie::expr::Closure*>(std::dynamic_pointer_cast<pie::expr::Fix>(exprs[i])->funcs[0].get());
+    };
+
+    const auto plus    = closure(1);
+    const auto swapped = closure(4);
+    REQUIRE(plus);
+    REQUIRE(swapped);
+
+    pie::test::Capture c{};
+    pie::interp::Visitor visitor{std::move(ops)};
+    for (const auto& expr : exprs) std::visit(visitor, expr->variant());
+    c.stop();
+
+    REQUIRE(plus->direct);
+    REQUIRE(plus->direct->call);
+    REQUIRE(swapped->direct);
+    REQUIRE(not swapped->direct->call); // arguments out of order
+}
+
+
+TEST_CASE("Inlining", "[Func][Optimize]") {
+    const auto src = R"(
+print = __builtin_print;
+infix + = (a, b) => __builtin_add(a, b);
+infix * = (a, b) => __builtin_mul(a, b);
+
+sq = (x) => x * x;
+add3 = (a: Int, b: Int, c: Int): Int => a + b + c;
+
+g = (x) => x;
+g = (x) => x + 1;
+
+fact = (n) => __builtin_conditional(__builtin_lt(n, 2), 1, n * fact(__builtin_sub(n, 1)));
+
+print(sq(3));
+print(add3(sq(2), 1, sq(sq(2))));
+print(g(1));
+print(fact(5));
+print(add3(c = 1, a = 2, b = 3));
+print(add3(1)(2, 3));
+)";
+
+    const auto unoptimized = [src] { const pie::test::Optimization O0{0}; return pie::test::run(src); }();
+
+    REQUIRE(unoptimized == "9\n21\n2\n120\n6\n6");
+    REQUIRE(pie::test::run(src) == unoptimized);
+
+
+    auto tokens = lex::lex(src);
+    pie::Parser p{std::move(tokens)};
+    auto [exprs, _] = p.parse();
+
+    pie::analysis::LexicalAnalysis anal;
+    for (const auto& expr : exprs) std::visit(anal, expr->variant());
+
+    pie::analysis::Inliner inliner;
+    inliner(exprs);
+
+    REQUIRE(inliner.inlinable.size() == 2); // sq and add3. g is reassigned and fact is recursive
+    REQUIRE(inliner.inlined == 5); // all the calls to them but the named and the curried ones
+
+
+    // the arguments are still checked
+    const auto src2 = R"(
+sq = (x: Int) => __builtin_mul(x, x);
+sq("no");
+)";
+
+    REQUIRE_THROWS_AS(pie::test::run(src2), pie::except::TypeMismatch);
+
+
+    // functions that only reach themselves through others, or through an operator, aren't inlined either
+    const auto src3 = R"(
+print = __builtin_print;
+odd = down = 0; .: declared up front, so the first of each pair can name the second
+
+even = (n) => __builtin_conditional(__builtin_eq(n, 0), true, odd(__builtin_sub(n, 1)));
+odd  = (n) => __builtin_conditional(__builtin_eq(n, 0), false, even(__builtin_sub(n, 1)));
+
+infix ~ = (a, b) => down(a, b);
+down = (a, b) => __builtin_conditional(__builtin_lt(a, 1), b, __builtin_sub(a, 1) ~ __builtin_add(b, 2));
+
+twice = (x) => __builtin_mul(x, 2);
+
+print(even(4));
+print(down(3, 0));
+print(twice(down(1, 1)));
+)";
+
+    auto tokens3 = lex::lex(src3);
+    pie::Parser p3{std::move(tokens3)};
+    auto [exprs3, _3] = p3.parse();
+
+    for (const auto& expr : exprs3) std::visit(anal, expr->variant());
+
+    pie::analysis::Inliner inliner3;
+    inliner3(exprs3);
+
+    REQUIRE(inliner3.inlinable.size() == 1); // only twice
+    REQUIRE(pie::test::run(src3) == "true\n6\n6");
+}
+
+
+TEST_CASE("Currying", "[Func]") {
+    const auto src = R"(
+print = __builtin_print;
+add4 = (a: Int, b: Int, c: Int, d: Int): Int => __builtin_add(__builtin_add(a, b), __builtin_add(c, d));
+same = (T: Type, x: T): T => x;
+
+one = add4(1);
+two = one(2);
+three = two(3);
+
+print(three(4));
+print(two(30, 40));
+print(one(b = 20)(300, 400));
+print(add4(1)(2)(3)(4));
+print(same(Int)(7));
+print(same(String)("hi"));
+
+adders = (n) => add4(n, n);
+print(adders(1)(2, 3));
+)";
+
+    REQUIRE(pie::test::run(src) == "10\n73\n721\n10\n7\nhi\n7");
+
+    // still checked against the bound type
+    REQUIRE_THROWS_AS(pie::test::run(R"(
+same = (T: Type, x: T): T => x;
+same(Int)("no");
+)"), pie::except::TypeMismatch);
+
+
+    // each partial application carries only the arguments bound so far
+    pie::Session session;
+    session.eval("add4 = (a: Int, b: Int, c: Int, d: Int): Int => __builtin_add(__builtin_add(a, b), __builtin_add(c, d));");
+
+    const auto three = session.eval("add4(1)(2)(3);");
+    REQUIRE(three);
+    REQUIRE(get<expr::Closure>(*three).bound.size() == 3);
+    REQUIRE(get<expr::Closure>(*three).params.size() == 1);
+}
+
+
+
+TEST_CASE("Expanding a Pack Again", "[Pack]") {
+    const auto src = R"(
+print = __builtin_print;
+add3 = (a: Int, b: Int, c: Int) => __builtin_add(a, __builtin_add(b, c));
+add4 = (a: Int, b: Int, c: Int, d: Int) => __builtin_add(add3(a, b, c), d);
+count = (xs: ...Any) => __builtin_len(xs);
+
+f = (xs: ...Int) => {
+    print(xs...);
+    print(add3(xs...));
+    print(add4(xs...)(4));
+    print(count(0, xs..., xs...));
+    print(xs...);
+};
+
+f(1, 2, 3);
+)";
+
+    // the pack is read in place by every call, and still all there after
+    REQUIRE(pie::test::run(src) == "1 2 3\n6\n10\n7\n1 2 3");
+}
+
+
+
+TEST_CASE("Positional Calls", "[Func]") {
+    const auto src = R"(
+print = __builtin_print;
+add = (a: Int, b: Int): Int => __builtin_add(a, b);
+apply = (f, x) => f(x);
+quote = (e: Syntax) => __builtin_eval(e);
+count = (xs: ...Any) => __builtin_len(xs);
+same = (T: Type, x: T): T => x;
+
+print(add(1, 2));
+print(add(b = 1, a = 2));
+print(add(1)(2));
+print(apply((n) => add(n, 10), 5));
+print(quote(__builtin_add(1, 2)));
+print(count(4, 5, 6));
+print(same(Int, 7));
+)";
+
+    REQUIRE(pie::test::run(src) == "3\n3\n3\n15\n3\n3\n7");
+
+    pie::Parser p{lex::lex(src)};
+    auto [exprs, _] = p.parse();
+
+    pie::analysis::LexicalAnalysis anal;
+    for (const auto& expr : exprs) std::visit(anal, expr->variant());
+
+    const auto call = [&exprs] (const size_t i) {
+        return std::dynamic_pointer_cast<expr::Call>(std::dynamic_pointer_cast<expr::Call>(exprs[i])->args[0]);
+    };
+
+    REQUIRE(call(6)->positional);
+    REQUIRE_FALSE(call(7)->positional); // named
+    REQUIRE(call(8)->positional); // curried, but that's up to the callee
+
+    const auto closure = [&exprs] (const size_t i) {
+        return std::dynamic_pointer_cast<expr::Closure>(std::dynamic_pointer_cast<expr::Assignment>(exprs[i])->rhs);
+    };
+
+    REQUIRE(closure(1)->dependencies().plain);
+    REQUIRE_FALSE(closure(4)->dependencies().plain); // variadic
+    REQUIRE_FALSE(closure(5)->dependencies().plain); // `x: T`
+}
+
+
+
+TEST_CASE("Constant Folding", "[Optimize]") {
+    const auto src = R"(
+print = __builtin_print;
+infix(+) + = (a, b) => __builtin_add(a, b);
+infix(+ +) * = (a, b) => __builtin_mul(a, b);
+
+hour = __builtin_mul(60, 60);
+day = hour * 24;
+half = __builtin_div(1.0, 2);
+greeting = __builtin_concat("Hello", ", ", "World");
+
+print(day);
+print(half);
+print(greeting);
+print(__builtin_conditional(__builtin_gt(day, 1000), "big", "small"));
+print(match hour {
+    = 0 => "zero";
+    : String => "string";
+    n: Int => n + 1;
+    _ => "other";
+});
+
+count = 0;
+count = __builtin_add(count, 1);
+print(count);
+)";
+
+    const auto unoptimized = [src] { const pie::test::Optimization O0{0}; return pie::test::run(src); }();
+
+    REQUIRE(unoptimized == "86400\n0.500000\nHello, World\nbig\n3601\n1");
+    REQUIRE(pie::test::run(src) == unoptimized);
+
+
+    const auto analysed = [] (const std::string& src) {
+        pie::Parser p{lex::lex(src)};
+        auto [exprs, _] = p.parse();
+
+        pie::analysis::LexicalAnalysis anal;
+        for (const auto& expr : exprs) std::visit(anal, expr->variant());
+
+        return exprs;
+    };
+
+    auto exprs = analysed(src);
+
+    pie::analysis::ConstantFolder<pie::interp::Visitor> folder;
+    folder(exprs);
+
+    const auto has = [lines = folder.report()] (const std::string& line) { return std::ranges::find(lines, line) != lines.end(); };
+
+    REQUIRE(has("folded `__builtin_mul(60, 60)` to `3600`"));
+    REQUIRE(has("folded `(3600 * 24)` to `86400`"));
+    REQUIRE(has("folded `__builtin_div(1.0, 2)` to `0.5`"));
+    REQUIRE(has("folded `__builtin_gt(86400, 1000)` to `true`"));
+    REQUIRE(has("pruned 3 cases of a match on `3600`"));
+    REQUIRE(has("propagated `hour` to 2 uses"));
+    REQUIRE(folder.constants.size() == 4); // hour, day, half, and greeting. count is reassigned
+
+
+    // nothing that can fail gets folded
+    auto exprs2 = analysed(R"(
+__builtin_div(1, 0);
+__builtin_mod(1.5, 2);
+__builtin_to_int("x");
+)");
+
+    pie::analysis::ConstantFolder<pie::interp::Visitor> folder2;
+    folder2(exprs2);
+    REQUIRE(folder2.report().empty());
+
+
+    // `Syntax` parameters see the expressions they're passed, so programs with them are left alone
+    auto exprs3 = analysed(R"(
+show = (e: Syntax) => e;
+show(__builtin_add(1, 2));
+)");
+
+    pie::analysis::ConstantFolder<pie::interp::Visitor> folder3;
+    folder3(exprs3);
+    REQUIRE(folder3.report().empty());
+
+    // ...and so are programs that import one
+    {
+        const pie::test::ScratchDir scratch{"pie_fold_syntax_test"};
+
+        std::ofstream{"pie_fold_syntax.pie"} << "(e: ...Syntax) => e;";
+        auto exprs4 = analysed(R"(
+show = import pie_fold_syntax;
+show(__builtin_add(1, 2));
+)");
+
+        pie::analysis::ConstantFolder<pie::interp::Visitor> folder4;
+        folder4(exprs4);
+        REQUIRE(folder4.report().empty());
+    }
+
+    // the word on its own doesn't count
+    auto exprs5 = analysed(R"(
+Syntax = "Syntax";
+__builtin_add(1, 2);
+)");
+
+    pie::analysis::ConstantFolder<pie::interp::Visitor> folder5;
+    folder5(exprs5);
+    REQUIRE(folder5.report() == std::vector<std::string>{"folded `__builtin_add(1, 2)` to `3`"});
+}
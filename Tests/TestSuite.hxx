@@ -3,6 +3,8 @@
 #include <iostream>
 #include <string>
 #include <cstdio>
+#include <utility>
+#include <filesystem>
 #include <unistd.h>
 
 
@@ -10,7 +12,9 @@
 #include "../Preprocessor/Preprocessor.hxx"
 #include "../Parser/Parser.hxx"
 #include "../Analysis/LexicalScoping.hxx"
+#include "../Analysis/Optimizer.hxx"
 #include "../Interp/Interpreter.hxx"
+#include "../Utils/Session.hxx"
 
 
 inline namespace pie {
@@ -20,6 +24,7 @@ struct Capture {
     int oldfd{-1}; FILE* tmp{nullptr}; std::string s; bool stopped{false};
 
     Capture() {
+        pie::util::out().flush();
         tmp = std::tmpfile();
 
         oldfd = dup(STDOUT_FILENO);
@@ -29,6 +34,7 @@ struct Capture {
 
     std::string stop() {
         if (stopped) return s;
+        pie::util::out().flush();
         std::cout.flush(); std::fflush(stdout);
 
         dup2(oldfd, STDOUT_FILENO); close(oldfd);
@@ -69,6 +75,45 @@ struct Capture {
 
 
 
+// sets the optimization level for as long as it's alive. A failing REQUIRE can't leave it changed for the next test
+struct Optimization {
+    const int was;
+
+    explicit Optimization(const int level) : was{std::exchange(pie::analysis::optimization(), level)} {}
+    ~Optimization() { pie::analysis::optimization() = was; }
+
+    Optimization(const Optimization&) = delete;
+    Optimization& operator=(const Optimization&) = delete;
+};
+
+
+
+// a fresh directory under the system's temp dir, and the working directory for as long as it's alive.
+// Modules a test writes are imported from there and are gone afterwards, even when a REQUIRE fails
+struct ScratchDir {
+    const std::filesystem::path was, dir;
+
+    explicit ScratchDir(const std::string& name)
+    : was{std::filesystem::current_path()}, dir{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        std::filesystem::current_path(dir);
+    }
+
+    ~ScratchDir() {
+        std::error_code ec; // nothing to do about it in a destructor
+        std::filesystem::current_path(was, ec);
+        std::filesystem::remove_all(dir, ec);
+
+        pie::modules::table().clear(); // the next test's modules could have the same relative names
+    }
+
+    ScratchDir(const ScratchDir&) = delete;
+    ScratchDir& operator=(const ScratchDir&) = delete;
+};
+
+
+
 std::string run(const char* src) {
 
     // auto processed_src = preprocess(src, ".");
@@ -87,6 +132,8 @@ std::string run(const char* src) {
     for (const auto& expr : exprs)
         std::visit(anal, expr->variant());
 
+    pie::analysis::optimize(exprs);
+
     Capture c{};
 
     interp::Visitor visitor{std::move(ops)};
@@ -22,6 +22,38 @@ namespace type {
         return T == *this or t->involvesName(T.text());
     }
 
+    // every node of the expression, and the types in its unions. The analysis gives a node the ID of the variable its text names,
+    // so that's all there is to compare. Comparing the text would print the whole subtree again at every level
+    template <typename Node, typename Sub>
+    static bool anyNode(expr::ExprPtr e, Node&& node, Sub&& sub) {
+        bool found = false;
+
+        analysis::walk(e, [&node, &sub, &found] (const expr::ExprPtr& e) {
+            if (found) return;
+
+            found = node(*e);
+            if (const auto onion = dynamic_cast<const expr::Union*>(e.get()); onion and not found) found = std::ranges::any_of(onion->types, sub);
+        });
+
+        return found;
+    }
+
+    bool ExprType::involvesName(const std::string_view name) const {
+        return anyNode(t,
+            [name] (const expr::Expr& e) { const auto n = dynamic_cast<const expr::Name*>(&e); return n and n->name == name; },
+            [name] (const TypePtr& type) { return type->involvesName(name); }
+        );
+    }
+
+    bool ExprType::involvesID(const std::function<bool(ssize_t)>& bound) const {
+        if (ID >= 0 and bound(ID)) return true; // the whole type names a variable
+
+        return anyNode(t,
+            [&bound] (const expr::Expr& e) { return e.ID >= 0 and bound(e.ID); },
+            [&bound] (const TypePtr& type) { return type->involvesID(bound); }
+        );
+    }
+
     bool ExprType::operator>(const Type& other) const {
         if (dynamic_cast<const TryReassign*>(&other)) return true;
         // if (not dynamic_cast<const ExprType   *>(&other)) return false;
@@ -203,6 +235,22 @@ namespace type {
         return false;
     }
 
+    bool UnionType::involvesName(const std::string_view name) const {
+        for (const auto& type : types)
+            if (type->involvesName(name)) return true;
+
+        return false;
+    }
+
+    bool UnionType::involvesID(const std::function<bool(ssize_t)>& bound) const {
+        if (ID >= 0 and bound(ID)) return true;
+
+        for (const auto& type : types)
+            if (type->involvesID(bound)) return true;
+
+        return false;
+    }
+
     bool UnionType::typeCheck(interp::Visitor* visitor, [[maybe_unused]] const value::Value& v, const TypePtr& other) const {
         return std::ranges::any_of(types, [visitor, &v, &other](const auto& type) { return type->typeCheck(visitor, v, other); });
     }
@@ -233,6 +281,22 @@ namespace type {
         return ret->involvesT(T);
     }
 
+    bool FuncType::involvesName(const std::string_view name) const {
+        for (const auto& type : params)
+            if (type->involvesName(name)) return true;
+
+        return ret->involvesName(name);
+    }
+
+    bool FuncType::involvesID(const std::function<bool(ssize_t)>& bound) const {
+        if (ID >= 0 and bound(ID)) return true;
+
+        for (const auto& type : params)
+            if (type->involvesID(bound)) return true;
+
+        return ret->involvesID(bound);
+    }
+
     bool FuncType::operator>(const Type& other) const {
         if (dynamic_cast<const TryReassign*>(&other)) return true;
         if (not dynamic_cast<const FuncType*>(&other)) return false;
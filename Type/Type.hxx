@@ -1,8 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <functional>
 
 
 inline namespace pie {
@@ -29,9 +31,15 @@ namespace type {
     struct Type {
 
         ssize_t ID = -1;
+        ssize_t space = -1; // same as `Expr::space`
         virtual std::string text(const size_t = 0) const = 0;
 
         virtual bool involvesT(const Type&) const = 0;
+        // same as `involvesT(ExprType{Name{name}})`, without building the type
+        virtual bool involvesName(const std::string_view name) const { return text() == name; }
+        // the same for every name in the type at once: whether `bound` holds for the ID of any of them.
+        // one lookup per name, instead of asking about every name that's bound somewhere
+        virtual bool involvesID(const std::function<bool(ssize_t)>& bound) const { return ID >= 0 and bound(ID); }
         virtual bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr&) const = 0;
 
         virtual bool operator==(const Type& other) const { return text() == other.text(); }
@@ -52,6 +60,8 @@ namespace type {
 
         std::string text(const size_t indent = 0) const override;
         bool involvesT(const Type& T) const override;
+        bool involvesName(const std::string_view name) const override;
+        bool involvesID(const std::function<bool(ssize_t)>& bound) const override;
         bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr& other) const override { return *this >= *other; }
 
         bool operator>(const Type& other) const override;
@@ -142,6 +152,8 @@ namespace type {
 
         std::string text(const size_t indent = 0) const override;
         bool involvesT(const Type& T) const override;
+        bool involvesName(const std::string_view name) const override;
+        bool involvesID(const std::function<bool(ssize_t)>& bound) const override;
         bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr&) const override;
 
         bool operator>(const Type& other) const override;
@@ -174,6 +186,8 @@ namespace type {
 
         std::string text(const size_t = 0) const override;
         bool involvesT(const Type& T) const override;
+        bool involvesName(const std::string_view name) const override;
+        bool involvesID(const std::function<bool(ssize_t)>& bound) const override;
         bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr& other) const override { return *this >= *other; }
 
         bool operator>(const Type& other) const override;
@@ -189,6 +203,8 @@ namespace type {
 
         std::string text(const size_t = 0) const override;
         bool involvesT(const Type& T) const override { return type->involvesT(T); }
+        bool involvesName(const std::string_view name) const override { return type->involvesName(name); }
+        bool involvesID(const std::function<bool(ssize_t)>& bound) const override { return (ID >= 0 and bound(ID)) or type->involvesID(bound); }
         bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr& other) const override { return *this >= *other; }
 
         bool operator>(const Type& other) const override;
@@ -204,6 +220,8 @@ namespace type {
 
         std::string text(const size_t = 0) const override;
         bool involvesT(const Type& T) const override { return type->involvesT(T); }
+        bool involvesName(const std::string_view name) const override { return type->involvesName(name); }
+        bool involvesID(const std::function<bool(ssize_t)>& bound) const override { return (ID >= 0 and bound(ID)) or type->involvesID(bound); }
         bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr& other) const override {
             // if (std::holds_alternative<value::ListValue>(v)) {
             //     const auto& l = get<value::ListValue>(v);
@@ -227,6 +245,10 @@ namespace type {
 
         std::string text(const size_t indent = 0) const override;
         bool involvesT(const Type& T) const override { return key_type->involvesT(T) or val_type->involvesT(T); }
+        bool involvesName(const std::string_view name) const override { return key_type->involvesName(name) or val_type->involvesName(name); }
+        bool involvesID(const std::function<bool(ssize_t)>& bound) const override {
+            return (ID >= 0 and bound(ID)) or key_type->involvesID(bound) or val_type->involvesID(bound);
+        }
         bool typeCheck(interp::Visitor*, const value::Value&, const TypePtr& other) const override { return *this >= *other; }
 
         bool operator>(const Type& other) const override;
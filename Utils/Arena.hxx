@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <atomic>
+#include <cstddef>
+
+
+inline namespace pie {
+namespace util {
+
+
+// bump allocator for things that mostly die together (like the nodes of one parse).
+// it only replaces the malloc behind each allocation, not the reference counting: nodes are still `shared_ptr`s.
+// nothing is freed individually. The arena counts what it handed out, and the whole buffer goes away once its owner
+// let go of it and the last allocation was given back. So a single surviving node keeps all of it alive
+// (closures keep their bodies around long after the parser is)
+class Arena {
+    std::pmr::monotonic_buffer_resource resource{64 * 1024};
+    std::atomic<size_t> refs{1}; // the owner, plus every allocation that wasn't given back yet
+
+    Arena() = default;
+    ~Arena() = default;
+
+public:
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    struct Drop { void operator()(Arena* const a) const noexcept { a->drop(); } };
+
+    // the owner's handle. Dropping it doesn't free anything nodes still use
+    [[nodiscard]] static std::unique_ptr<Arena, Drop> make() { return std::unique_ptr<Arena, Drop>{new Arena}; }
+
+
+    [[nodiscard]] void* allocate(const size_t bytes, const size_t align) {
+        refs.fetch_add(1, std::memory_order_relaxed);
+        return resource.allocate(bytes, align);
+    }
+
+    void drop() noexcept { if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this; }
+};
+
+using ArenaPtr = std::unique_ptr<Arena, Arena::Drop>;
+
+
+// a plain pointer to the arena, so the copy of it a control block keeps is just that.
+// every allocation is counted once by the arena, on top of the reference count of the shared_ptr made with it
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena* const a) noexcept : arena{a} {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena{other.arena} {}
+
+
+    [[nodiscard]] T* allocate(const size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T*, size_t) noexcept { arena->drop(); } // the memory itself goes with the arena
+
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+};
+
+
+} // namespace util
+} // namespace pie
@@ -4,12 +4,15 @@
 #include <string>
 #include <filesystem>
 #include <utility>
+#include <fstream>
 
 #include "../Lex/Lexer.hxx"
 #include "../Preprocessor/Preprocessor.hxx"
 #include "../Parser/Parser.hxx"
 #include "../Analysis/LexicalScoping.hxx"
+#include "../Analysis/Optimizer.hxx"
 #include "../Interp/Interpreter.hxx"
+#include "Session.hxx"
 
 
 
@@ -22,6 +25,13 @@ namespace cli {
         std::cout << "print pre-processed: -pre"   << '\n';
         std::cout << "don't run program:   -run"   << '\n';
         std::cout << "print this message:  -help"   << '\n';
+        std::cout << "flush every print:   -unbuffered" << '\n';
+        std::cout << "sample every 1ms:    -profile"   << '\n';
+        std::cout << "sample every call:   -profile-calls" << '\n';
+        std::cout << "count work done:     -count" << '\n';
+        std::cout << "don't optimize:      -O0" << '\n';
+        std::cout << "optimize (default):  -O1" << '\n';
+        std::cout << "print what -O1 did:  -opt-report" << '\n';
     }
 
 
@@ -32,26 +42,21 @@ namespace cli {
         const bool print_parsed,
         const bool run
     ) {
-        Parser parser{canonical_root};
-        interp::Visitor visitor;
+        Session session{canonical_root}; // root in repl mode is where we ran the interpreter
 
         for (;;) try {
             std::string line;
             std::print(">>> ");
-            std::getline(std::cin, line);
-            if (line.back() != ';') line += ';';
+            if (not std::getline(std::cin, line)) break; // EOF
+            if (line.empty() or line.back() != ';') line += ';';
 
 
-            constexpr auto REPL = true;
-            auto processed_line = preprocess<REPL>(std::move(line), canonical_root); // root in repl mode is where we ran the interpret
-            if (print_preprocessed) std::println(std::clog, "{}", processed_line);
+            if (print_preprocessed) std::println(std::clog, "{}", session.preprocess(line));
 
-            Tokens v = lex::lex(std::move(processed_line));
-            if (print_tokens) std::println(std::clog, "{}", v);
+            const auto& tokens = session.lex(line);
+            if (print_tokens) std::println(std::clog, "{}", tokens);
 
-            if (v.empty()) continue;
-
-            auto [exprs, ops] = parser.parse(std::move(v));
+            const auto exprs = session.compile();
 
             if (print_parsed) for(const auto& expr : exprs) std::println(std::clog, "{};", expr->stringify(0));
 
@@ -59,13 +64,9 @@ namespace cli {
 
 
             if (run) {
-                visitor.addOperators(std::move(ops));
-
-                if (not exprs.empty()) {
-                    Value value;
-                    for (auto&& expr : exprs) value = std::visit(visitor, std::move(expr)->variant());
-
-                    std::println("{}", stringify(value));
+                if (const auto value = session.run(exprs)) {
+                    util::out().flush();
+                    std::println("{}", stringify(*value));
                 }
             }
         }
@@ -76,6 +77,26 @@ namespace cli {
 
 
 
+    // -count and -profile output. After the program's output, and after its error if it failed (see main.cc),
+    // since a failing run is when these are most useful
+    void report(const std::filesystem::path& fname) {
+        util::out().flush();
+
+        if (const auto& counters = util::counters(); counters) counters->report(std::clog);
+
+        if (const auto& profiler = util::profiler(); profiler) {
+            auto folded = fname;
+            folded.replace_extension(".folded");
+
+            std::ofstream fout{folded};
+            profiler->collapsed(fout); // for flamegraphs
+
+            profiler->table(std::clog);
+            std::println(std::clog, "collapsed stacks written to {}", folded.string());
+        }
+    }
+
+
     void runFile(
         const std::filesystem::path fname,
         const bool print_preprocessed,
@@ -89,11 +110,13 @@ namespace cli {
         // if (print_preprocessed) std::println(std::clog, "{}", processed_src);
         auto processed_src = std::move(src);
 
-        Tokens v = lex::lex(std::move(processed_src));
+        Tokens v = lex::lex(processed_src);
         if (print_tokens) std::println(std::clog, "{}", v);
 
         if (v.empty()) return;
 
+        modules::preload(v, fname); // the whole import graph, in parallel
+
         Parser p{std::move(v), fname};
 
         auto [exprs, ops] = p.parse();
@@ -108,12 +131,14 @@ namespace cli {
         for (auto& expr : exprs)
             std::visit(anal, expr->variant());
 
-        if (run) {
-
+        pie::analysis::optimize(exprs);
 
+        if (run) {
             interp::Visitor visitor{std::move(ops)};
             for (const auto& expr : exprs)
                 std::visit(visitor, expr->variant());
+
+            report(fname);
         }
     }
 
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <array>
+#include <string>
+#include <utility>
+#include <variant>
+#include <iostream>
 #include <stdx/tuple.hpp>
 
 #include "../Interp/Value.hxx"
@@ -68,6 +73,11 @@ struct Func {
     Lambda func;
     inline static constexpr size_t count = sizeof...(Ts) + not std::is_same_v<First, void>; // + 1 for First
 
+    inline static constexpr size_t arity = [] {
+        if constexpr (std::is_same_v<First, void>) return 0uz;
+        else return First::count;
+    }();
+
     template <size_t N, size_t M>
     auto get2() {
         static_assert(not std::is_same_v<First, void>);
@@ -82,123 +92,101 @@ struct Func {
 struct Any {};
 
 
-template <size_t SIZE, size_t N = 0, ConstexprString NAME, typename... Ts>
-requires (SIZE == 0)
-static Value execute(Func<NAME, Ts...> func, const std::vector<Value>&, const auto& that) {
-    static_assert(SIZE == decltype(func)::count);
+inline constexpr size_t alternatives = std::variant_size_v<pie::value::VariantType>;
 
-    return func.func(that);
+template <typename T>
+constexpr bool accepts(const size_t alternative) {
+    if constexpr (std::is_same_v<T, Any>) return true;
+    else return alternative == pie::value::alternativeOf<T>();
 }
 
-template <size_t SIZE, size_t N = 0, ConstexprString NAME, typename... Ts>
-requires (SIZE == 1)
-Value execute(Func<NAME, Ts...> func, const std::vector<Value>& args, const auto& that) {
-    if constexpr (N < decltype(func)::count) {
-        using T = decltype(func.template get2<N, 0>());
-
-        if constexpr (not std::is_same_v<T, Any>)
-            if (not std::holds_alternative<T>(args[0])) 
-                return execute<SIZE, N + 1>(func, args, that); // try the next type list
-
-
-        constexpr bool is_any1 = std::is_same_v<T, Any>;
-        std::conditional_t<is_any1, Value, T> v1;
-        if constexpr (is_any1) v1 = args[0];
-        else v1 = std::get<T>(args[0]);
-
-
-        return func.func(v1, that);
-    }
-
-    std::clog << "Function: ";
-    for (const char c: NAME)
-        std::clog << c;
-    puts("\nArgs:");
-    that->print(args[0]);
-    pie::util::error("Wrong type passed to function!");
+template <typename T>
+const auto& argAs(const Value& v) {
+    if constexpr (std::is_same_v<T, Any>) return v;
+    else return *std::get_if<T>(&v); // the table already made sure it's the right alternative
 }
 
-template <size_t SIZE, size_t N = 0, ConstexprString NAME, typename... Ts>
-requires (SIZE == 2)
-Value execute(Func<NAME, Ts...> func, const std::vector<Value>& args, const auto& that) {
-    if constexpr (N < decltype(func)::count) {
-        using T1 = decltype(func.template get2<N, 0>());
-        using T2 = decltype(func.template get2<N, 1>());
 
-        if constexpr (not std::is_same_v<T1, Any>)
-            if (not std::holds_alternative<T1>(args[0])) 
-                return execute<SIZE, N + 1>(func, args, that); // try the next type list
-
-        if constexpr (not std::is_same_v<T2, Any>)
-            if (not std::holds_alternative<T2>(args[1])) 
-                return execute<SIZE, N + 1>(func, args, that);
+// one entry per combination of argument alternatives, each pointing straight at the overload that takes them
+// so calling a builtin is one index computation and one indirect call, and the arguments are passed by reference
+template <typename F, typename That, size_t ARITY>
+struct Dispatch {
+    using Entry = Value (*)(const Value* const*, const That&);
 
+    template <size_t N>
+    using Param = decltype(F{}.template get2<N / ARITY, N % ARITY>());
 
-        constexpr bool is_any1 = std::is_same_v<T1, Any>;
-        typename std::conditional<is_any1, Value, T1>::type v1;
-        if constexpr (is_any1) v1 = args[0];
-        else v1 = std::get<T1>(args[0]);
 
+    template <size_t N, size_t... K>
+    static Value call(const Value* const* args, const That& that, std::index_sequence<K...>) {
+        return F{}.func(argAs<Param<N * ARITY + K>>(*args[K])..., that);
+    }
 
-        constexpr bool is_any2 = std::is_same_v<T2, Any>;
-        typename std::conditional<is_any2, Value, T2>::type v2;
-        if constexpr (is_any2) v2 = args[1];
-        else v2 = std::get<T2>(args[1]);
+    template <size_t N>
+    static Value call(const Value* const* args, const That& that) { return call<N>(args, that, std::make_index_sequence<ARITY>{}); }
+
+
+    static Value mismatch(const Value* const* args, const That& that) {
+        if constexpr (ARITY == 1) {
+            std::clog << "Function: " << F::name._str;
+            pie::util::out().write("\nArgs:\n");
+            that->print(*args[0]);
+            pie::util::error("Wrong type passed to function!");
+        }
+        else if constexpr (ARITY == 2) pie::util::error(std::string{"Wrong type passed to function: "} + F::name._str);
+        else pie::util::error("Wrong type passed to function!");
+    }
 
 
-        return func.func(v1, v2, that);
+    template <size_t N, size_t... K>
+    static constexpr bool matches(const std::array<size_t, ARITY>& alts, std::index_sequence<K...>) {
+        return (accepts<Param<N * ARITY + K>>(alts[K]) and ...);
     }
 
-    else {
-        std::string msg = "Wrong type passed to function: ";
-        for (const auto c : NAME)
-            msg += c;
-        pie::util::error(msg);
+    // overloads are tried in the order they're declared, same as a call would
+    template <size_t N = 0>
+    static constexpr Entry resolve(const std::array<size_t, ARITY>& alts) {
+        if constexpr (N == F::count) return &mismatch;
+        else if (matches<N>(alts, std::make_index_sequence<ARITY>{})) return &call<N>;
+        else return resolve<N + 1>(alts);
     }
-}
 
-template <size_t SIZE, size_t N = 0, ConstexprString NAME, typename... Ts>
-requires (SIZE == 3)
-Value execute(Func<NAME, Ts...> func, const std::vector<Value>& args, const auto& that) {
-    if constexpr (N < decltype(func)::count) {
-        using T1 = decltype(func.template get2<N, 0>());
-        using T2 = decltype(func.template get2<N, 1>());
-        using T3 = decltype(func.template get2<N, 2>());
 
-        if constexpr (not std::is_same_v<T1, Any>)
-            if (not std::holds_alternative<T1>(args[0])) 
-                return execute<SIZE, N + 1>(func, args, that); // try the next type list
+    static constexpr size_t cells = [] {
+        size_t n = 1;
+        for (size_t i{}; i < ARITY; ++i) n *= alternatives;
+        return n;
+    }();
 
-        if constexpr (not std::is_same_v<T2, Any>)
-            if (not std::holds_alternative<T2>(args[1])) 
-                return execute<SIZE, N + 1>(func, args, that);
+    inline static constexpr std::array<Entry, cells> table = [] {
+        std::array<Entry, cells> t{};
 
-        if constexpr (not std::is_same_v<T3, Any>)
-            if (not std::holds_alternative<T3>(args[2])) 
-                return execute<SIZE, N + 1>(func, args, that);
+        for (size_t cell{}; cell < cells; ++cell) {
+            std::array<size_t, ARITY> alts{};
 
+            for (size_t k = ARITY, rest = cell; k-- > 0; rest /= alternatives) alts[k] = rest % alternatives;
 
-        constexpr bool is_any1 = std::is_same_v<T1, Any>;
-        std::conditional_t<is_any1, Value, T1> v1;
-        if constexpr (is_any1) v1 = args[0];
-        else v1 = std::get<T1>(args[0]);
+            t[cell] = resolve(alts);
+        }
 
-
-        constexpr bool is_any2 = std::is_same_v<T2, Any>;
-        std::conditional_t<is_any2, Value, T2> v2;
-        if constexpr (is_any2) v2 = args[1];
-        else v2 = std::get<T2>(args[1]);
+        return t;
+    }();
+};
 
 
-        constexpr bool is_any3 = std::is_same_v<T3, Any>;
-        std::conditional_t<is_any3, Value, T3> v3;
-        if constexpr (is_any3) v3 = args[2];
-        else v3 = std::get<T3>(args[2]);
+template <ConstexprString NAME, typename... Ts, typename That, typename... Args>
+Value execute(const Func<NAME, Ts...>&, const That& that, const Args&... args) {
+    using F = Func<NAME, Ts...>;
+    static_assert(sizeof...(Args) == F::arity);
+    static_assert((std::is_same_v<Args, Value> and ...));
 
+    if constexpr (sizeof...(Args) == 0) return F{}.func(that);
+    else {
+        const Value* const argv[] = {&args...};
 
-        return func.func(v1, v2, v3, that);
+        size_t cell{};
+        ((cell = cell * alternatives + args.index()), ...);
 
+        return Dispatch<F, That, sizeof...(Args)>::table[cell](argv, that);
     }
-
-    else pie::util::error("Wrong type passed to function!");
 }
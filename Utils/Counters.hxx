@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <variant>
+#include <ostream>
+#include <source_location>
+
+#include "../Declarations.hxx"
+
+
+inline namespace pie {
+namespace util {
+
+
+// name of a node type, pulled out of the compiler's pretty function name, i.e: "Num" for expr::Num
+template <typename T>
+[[nodiscard]] constexpr std::string_view nodeName() {
+    std::string_view name = std::source_location::current().function_name();
+
+    name = name.substr(name.find("T = ") + 4);
+    name = name.substr(0, name.find_first_of(";]"));
+    name = name.substr(name.rfind("::") + 2);
+
+    return name;
+}
+
+template <typename T, size_t I = 0>
+[[nodiscard]] consteval size_t nodeIndex() {
+    if constexpr (std::is_same_v<std::variant_alternative_t<I, expr::Node>, T*>) return I;
+    else return nodeIndex<T, I + 1>();
+}
+
+template <size_t... Is>
+[[nodiscard]] constexpr auto nodeNames(std::index_sequence<Is...>) {
+    return std::array{nodeName<std::remove_pointer_t<std::variant_alternative_t<Is, expr::Node>>>()...};
+}
+
+
+// * counting mode * //
+// tallies of the work the interpreter does, instead of how long it took.
+// the same program always gives the same counts, so they can be checked against a golden file in CI
+struct Counters {
+    static constexpr size_t kinds = std::variant_size_v<expr::Node>;
+    static constexpr auto kind_names = nodeNames(std::make_index_sequence<kinds>{});
+
+    std::array<size_t, kinds> nodes{}; // evaluated nodes, by kind
+
+    size_t closure_calls{};
+    size_t inlined_calls{};
+    size_t type_checks{};
+    size_t env_lookups{};
+    size_t env_frames{}; // scopes walked by those lookups
+    size_t value_allocations{};
+
+    std::unordered_map<std::string, size_t> builtins; // calls, by name
+
+
+    template <typename T>
+    void node() { ++nodes[nodeIndex<T>()]; }
+
+
+    // `name count` per line, sorted by name. Counters that stayed at 0 are left out so the output only grows with the program
+    void report(std::ostream& os) const {
+        std::vector<std::pair<std::string, size_t>> lines{
+            {"closure_calls"    , closure_calls    },
+            {"inlined_calls"    , inlined_calls    },
+            {"type_checks"      , type_checks      },
+            {"env_lookups"      , env_lookups      },
+            {"env_frames"       , env_frames       },
+            {"value_allocations", value_allocations},
+        };
+
+        for (size_t i{}; i < kinds; ++i) lines.emplace_back("node." + std::string{kind_names[i]}, nodes[i]);
+        for (const auto& [name, n] : builtins) lines.emplace_back("builtin." + name, n);
+
+        std::ranges::sort(lines);
+
+        for (const auto& [name, n] : lines)
+            if (n) os << name << ' ' << n << '\n';
+    }
+};
+
+
+inline std::unique_ptr<Counters>& counters() {
+    static std::unique_ptr<Counters> c;
+    return c;
+}
+
+
+} // namespace util
+} // namespace pie
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#if __has_include(<sys/mman.h>)
+    #define PIE_HAS_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "utils.hxx"
+
+
+inline namespace pie {
+namespace util {
+
+
+// read-only view over a whole file
+// mapped when the platform lets us, so huge files are paged in as they're read instead of loaded up front
+class MappedFile {
+    const char* data{};
+    size_t size{};
+    bool mapped{};
+
+    std::string fallback; // where the contents live when the file couldn't be mapped
+
+public:
+    explicit MappedFile(const std::string& fname) {
+        #if PIE_HAS_MMAP
+        const int fd = ::open(fname.c_str(), O_RDONLY);
+        if (fd < 0) error("File \"" + fname + " \" not found!");
+
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 and S_ISREG(st.st_mode) and st.st_size > 0) {
+            void* const addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL); // we read front to back
+                data   = static_cast<const char*>(addr);
+                size   = static_cast<size_t>(st.st_size);
+                mapped = true;
+            }
+        }
+
+        ::close(fd);
+        if (mapped) return;
+        #endif
+
+        // empty files, pipes, or no mmap at all
+        fallback = readFile(fname);
+        data = fallback.data();
+        size = fallback.size();
+    }
+
+    ~MappedFile() {
+        #if PIE_HAS_MMAP
+        if (mapped) ::munmap(const_cast<char*>(data), size);
+        #endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+
+    [[nodiscard]] std::string_view view() const noexcept { return {data, size}; }
+};
+
+
+
+// hands out a file one line at a time, without the '\n'
+class LineReader {
+    MappedFile file;
+    size_t pos{};
+
+public:
+    explicit LineReader(const std::string& fname) : file{fname} {}
+
+    [[nodiscard]] bool hasNext() const noexcept { return pos < file.view().size(); }
+
+    [[nodiscard]] std::string_view next() noexcept {
+        const auto src = file.view();
+        if (pos >= src.size()) return {};
+
+        const auto* const start = src.data() + pos;
+        const auto* const nl    = static_cast<const char*>(std::memchr(start, '\n', src.size() - pos));
+
+        const size_t len = nl ? static_cast<size_t>(nl - start) : src.size() - pos;
+        pos += len + 1;
+
+        return {start, len};
+    }
+};
+
+
+} // namespace util
+} // namespace pie
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include "utils.hxx"
+#include "MappedFile.hxx"
+#include "../Lex/Lexer.hxx"
+
+
+inline namespace pie {
+namespace modules {
+
+
+// * module cache * //
+// an imported file is read and lexed once per process and its tokens are kept in `table()`.
+// they're also written to a `.piec` file next to the `.pie` one, so the next run can skip lexing altogether.
+// it's tokens and not the AST on purpose: how a module parses depends on the operators in scope where it's imported
+// the cache remembers the source's size and modification time, and a hash of it.
+// if the size and time still match the source isn't even opened. Otherwise it's hashed, so touching a file without changing it doesn't cost a relex
+
+inline std::unordered_map<std::string, Tokens>& table() {
+    static std::unordered_map<std::string, Tokens> modules;
+    return modules;
+}
+
+
+// FNV-1a. Not cryptographic, only needs to notice that a file changed
+[[nodiscard]] constexpr uint64_t hash(const std::string_view src) noexcept {
+    uint64_t h = 14695981039346656037ull;
+
+    for (const char c : src) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+
+// layout of a .piec file:
+// magic | version | source size | source mtime | source hash | token count | (kind: u8, length: u32, text)...
+inline constexpr char     magic[4] = {'P', 'I', 'E', 'C'};
+inline constexpr uint32_t version  = 2; // bump whenever the lexer or TokenKind changes
+
+
+// what the filesystem says about a source file. Cheap to get, unlike its hash
+struct Stamp {
+    uint64_t size {};
+    int64_t  mtime{};
+
+    bool operator==(const Stamp&) const = default;
+};
+
+[[nodiscard]] inline Stamp stampOf(const std::filesystem::path& source) {
+    std::error_code ec;
+    const auto size  = std::filesystem::file_size(source, ec);
+    if (ec) return {};
+
+    const auto mtime = std::filesystem::last_write_time(source, ec);
+    if (ec) return {};
+
+    // file times only tick every few milliseconds, so a file written just now could still change
+    // without its stamp changing. Until it settles it's only trusted by its hash
+    if (std::filesystem::file_time_type::clock::now() - mtime < std::chrono::seconds{2}) return {};
+
+    return {size, static_cast<int64_t>(mtime.time_since_epoch().count())};
+}
+
+
+enum class CacheHit { NONE, STAMP, HASH };
+
+
+[[nodiscard]] inline std::filesystem::path cachePath(std::filesystem::path source) {
+    return source.replace_extension(".piec");
+}
+
+
+// tokens from the cache file, if it was written for this exact source.
+// `source_hash` is only called when the stamp doesn't match. HASH means the cache is good but its stamp is out of date
+template <typename Hash>
+[[nodiscard]] inline CacheHit readCache(const std::filesystem::path& cache, const Stamp& stamp, Hash&& source_hash, Tokens& tokens) try {
+    using enum CacheHit;
+    const util::QuietErrors quiet; // a cache that vanished under us isn't worth an error message
+
+    std::error_code ec;
+    if (not std::filesystem::is_regular_file(cache, ec)) return NONE;
+
+    const util::MappedFile file{cache.string()};
+    std::string_view bytes = file.view();
+
+    const auto take = [&bytes] <typename T> (T& out) {
+        if (bytes.size() < sizeof(T)) return false;
+
+        std::memcpy(&out, bytes.data(), sizeof(T));
+        bytes.remove_prefix(sizeof(T));
+        return true;
+    };
+
+
+    char     file_magic[4];
+    uint32_t file_version;
+    Stamp    file_stamp;
+    uint64_t file_hash, count;
+
+    if (not take(file_magic) or std::memcmp(file_magic, magic, sizeof magic) != 0) return NONE;
+    if (not take(file_version) or file_version != version                        ) return NONE;
+    if (not take(file_stamp.size) or not take(file_stamp.mtime)                  ) return NONE;
+    if (not take(file_hash)) return NONE;
+
+    // a zero size stamp is what stampOf gives up with, so it never vouches for anything
+    const CacheHit hit = file_stamp == stamp and stamp.size ? STAMP : HASH;
+    if (hit == HASH and file_hash != source_hash()) return NONE;
+
+    if (not take(count)) return NONE;
+
+    tokens.clear();
+    tokens.reserve(count);
+
+    for (uint64_t i{}; i < count; ++i) {
+        uint8_t  kind;
+        uint32_t length;
+
+        if (not take(kind) or kind > static_cast<uint8_t>(TokenKind::END)) return NONE;
+        if (not take(length) or bytes.size() < length) return NONE;
+
+        tokens.emplace_back(static_cast<TokenKind>(kind), std::string{bytes.substr(0, length)});
+        bytes.remove_prefix(length);
+    }
+
+    return not tokens.empty() and tokens.back().kind == TokenKind::END ? hit : NONE;
+}
+catch (const std::exception&) {
+    return CacheHit::NONE; // a broken cache is just a cache miss
+}
+
+
+// best effort. A read-only directory just means no cache
+inline void writeCache(const std::filesystem::path& cache, const Stamp& stamp, const uint64_t source_hash, const Tokens& tokens) {
+    std::string bytes;
+    bytes.reserve(40 + tokens.size() * 8);
+
+    const auto put = [&bytes] (const auto& value) { bytes.append(reinterpret_cast<const char*>(&value), sizeof value); };
+
+    bytes.append(magic, sizeof magic);
+    put(version);
+    put(stamp.size);
+    put(stamp.mtime);
+    put(source_hash);
+    put(static_cast<uint64_t>(tokens.size()));
+
+    for (const auto& token : tokens) {
+        put(static_cast<uint8_t>(token.kind));
+        put(static_cast<uint32_t>(token.text.size()));
+        bytes += token.text;
+    }
+
+    // written under a temporary name first so a crash can never leave a half written cache behind
+    auto tmp = cache;
+    tmp += ".tmp";
+
+    {
+        std::ofstream fout{tmp, std::ios::binary | std::ios::trunc};
+        if (not fout.is_open()) return;
+
+        fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (not fout) return;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, cache, ec);
+    if (ec) std::filesystem::remove(tmp, ec);
+}
+
+
+
+[[nodiscard]] inline std::string canonicalName(std::filesystem::path path) {
+    path.replace_extension(".pie");
+
+    std::error_code ec;
+    auto canonical = std::filesystem::canonical(path, ec);
+    if (ec) util::error("File \"" + path.string() + " \" not found!");
+
+    return canonical.string();
+}
+
+
+// reads and lexes (or loads from .piec) the module at canonical path `key`, leaving the table alone
+[[nodiscard]] inline Tokens read(const std::string& key) {
+    Tokens tokens;
+    {
+        // only mapped (and hashed) when the cache can't vouch for the source by its stamp alone
+        std::optional<util::MappedFile> source;
+        std::optional<uint64_t> source_hash;
+        const auto src    = [&] { if (not source) source.emplace(key); return source->view(); };
+        const auto hashed = [&] { if (not source_hash) source_hash = hash(src()); return *source_hash; };
+
+        const auto cache = cachePath(key);
+        const auto stamp = stampOf(key);
+
+        switch (readCache(cache, stamp, hashed, tokens)) {
+            case CacheHit::STAMP: break;
+
+            case CacheHit::HASH: // same source, new stamp. Rewrite it so the next run doesn't hash again
+                writeCache(cache, stamp, hashed(), tokens);
+                break;
+
+            case CacheHit::NONE:
+                lex::lex(src(), tokens);
+                if (not tokens.empty()) writeCache(cache, stamp, hashed(), tokens);
+                break;
+        }
+    }
+
+    if (tokens.empty()) util::error("Can't import an empty file!");
+
+
+    // whoever splices these tokens in has a different root directory
+    const auto dir = std::filesystem::path{key}.remove_filename();
+    for (size_t i{}; i + 1 < tokens.size(); ++i)
+        if (tokens[i].kind == TokenKind::IMPORT and tokens[i + 1].kind == TokenKind::NAME)
+            tokens[i + 1].text = (dir / tokens[i + 1].text).string();
+
+    return tokens;
+}
+
+
+// tokens of the module at `path` (ending with END), with nested imports already made absolute
+[[nodiscard]] inline const Tokens& load(const std::filesystem::path& path) {
+    auto key = canonicalName(path);
+    if (const auto found = table().find(key); found != table().cend()) return found->second;
+
+    auto tokens = read(key);
+    return table().emplace(std::move(key), std::move(tokens)).first->second;
+}
+
+
+
+// * parallel preloading * //
+// parsing has to go in order (a module can define operators the rest of the file is parsed with),
+// but reading and lexing every module in the import graph doesn't, so that part is spread over all cores up front.
+// this only warms `table()`. Missing or broken modules are skipped here and reported by `load` when the parser gets to them
+
+// modules imported by `tokens` that aren't in the table yet
+inline void importsOf(const Tokens& tokens, const std::filesystem::path& dir, std::unordered_set<std::string>& seen, std::vector<std::string>& found) {
+    for (size_t i{}; i + 1 < tokens.size(); ++i) {
+        if (tokens[i].kind != TokenKind::IMPORT or tokens[i + 1].kind != TokenKind::NAME) continue;
+
+        auto path = dir / tokens[i + 1].text;
+        path.replace_extension(".pie");
+
+        std::error_code ec;
+        auto key = std::filesystem::canonical(path, ec).string();
+        if (ec or table().contains(key) or not seen.insert(key).second) continue;
+
+        found.push_back(std::move(key));
+    }
+}
+
+
+inline void preload(const Tokens& tokens, const std::filesystem::path& file) {
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> frontier;
+    importsOf(tokens, std::filesystem::path{file}.remove_filename(), seen, frontier);
+
+    // one level of the graph at a time. Everything in a level is independent
+    while (not frontier.empty()) {
+        std::vector<std::optional<Tokens>> results(frontier.size());
+
+        std::atomic<size_t> next{};
+        const auto work = [&frontier, &results, &next] {
+            // the output is shared with the main thread, and a failure here gets reported by `load` anyway
+            const util::QuietErrors quiet;
+
+            for (size_t i; (i = next++) < frontier.size();) try {
+                results[i] = read(frontier[i]);
+            }
+            catch (const std::exception&) {} // `load` will say what's wrong, in order
+        };
+
+        #if defined(WEB_PIE)
+        work(); // no threads on the web build
+        #else
+        {
+            const size_t threads = std::min<size_t>(frontier.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+            std::vector<std::jthread> workers;
+            workers.reserve(threads - 1);
+            for (size_t i = 1; i < threads; ++i) workers.emplace_back(work);
+
+            work();
+        } // joined here
+        #endif
+
+
+        std::vector<std::string> next_level;
+        for (size_t i{}; i < frontier.size(); ++i) {
+            if (not results[i]) continue;
+
+            importsOf(*results[i], {}, seen, next_level); // nested imports are already absolute
+            table().emplace(std::move(frontier[i]), std::move(*results[i]));
+        }
+
+        frontier = std::move(next_level);
+    }
+}
+
+
+} // namespace modules
+} // namespace pie
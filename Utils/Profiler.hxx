@@ -0,0 +1,154 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <concepts>
+#include <algorithm>
+#include <ostream>
+#include <format>
+
+
+inline namespace pie {
+namespace util {
+
+
+// * sampling profiler * //
+// the interpreter keeps a stack of Pie level frames (closures, operators, builtins) while a profiler is on.
+// a clock thread bumps `ticks` at a fixed interval, and the interpreter only looks at it when entering or leaving a frame,
+// so every tick is charged to whatever stack was running when it went off. No signals, no unwinding.
+// in counting mode there's no clock: every frame entry is one sample, which makes the output deterministic
+class Profiler {
+    std::vector<std::string> stack;
+    std::unordered_map<std::string, size_t> samples; // "main;f;g" -> how many samples had exactly that stack
+    size_t total{};
+
+    std::atomic<size_t> ticks{};
+    bool counting{};
+
+    std::jthread clock; // last, so it stops before the rest goes away
+
+
+    void record(const size_t n) {
+        std::string key = "main";
+        for (const auto& frame : stack) (key += ';') += frame;
+
+        samples[key] += n;
+        total += n;
+    }
+
+    void poll() {
+        if (const size_t n = ticks.exchange(0, std::memory_order_relaxed)) record(n);
+    }
+
+public:
+    // one sample per frame entered
+    Profiler() : counting{true} {}
+
+    explicit Profiler(const std::chrono::microseconds interval)
+    : clock{[this, interval] (const std::stop_token stop) {
+        while (not stop.stop_requested()) {
+            std::this_thread::sleep_for(interval);
+            ticks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }}
+    {}
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+
+    void enter(std::string name) {
+        poll(); // whatever was running until now gets the ticks, not the new frame
+        stack.push_back(std::move(name));
+
+        if (counting) record(1);
+    }
+
+    void leave() {
+        poll();
+        stack.pop_back();
+    }
+
+
+    // one line per distinct stack: `main;f;g 42`. What flamegraph.pl and speedscope read
+    void collapsed(std::ostream& os) {
+        poll();
+
+        std::vector<std::pair<std::string_view, size_t>> lines{samples.begin(), samples.end()};
+        std::ranges::sort(lines);
+
+        for (const auto& [stack, n] : lines) os << stack << ' ' << n << '\n';
+    }
+
+
+    // self: samples where the function was the one running. total: samples where it was anywhere on the stack
+    void table(std::ostream& os) {
+        poll();
+        if (not total) return;
+
+        std::unordered_map<std::string_view, std::pair<size_t, size_t>> functions; // self, total
+
+        for (const auto& [key, n] : samples) {
+            std::unordered_set<std::string_view> seen; // recursion only counts once towards total
+
+            for (size_t start{}; start <= key.size();) {
+                const size_t end = std::min(key.find(';', start), key.size());
+                const std::string_view frame{key.data() + start, end - start};
+
+                if (seen.insert(frame).second) functions[frame].second += n;
+                if (end == key.size()) functions[frame].first += n; // leaf
+
+                start = end + 1;
+            }
+        }
+
+        std::vector<std::pair<std::string_view, std::pair<size_t, size_t>>> rows{functions.begin(), functions.end()};
+        std::ranges::sort(rows, [] (const auto& a, const auto& b) {
+            return a.second.first != b.second.first ? a.second.first > b.second.first : a.first < b.first;
+        });
+
+        const auto percent = [this] (const size_t n) { return 100.0 * static_cast<double>(n) / static_cast<double>(total); };
+
+        os << std::format("{:>8} {:>8} {:>10}  {}\n", "self%", "total%", "samples", "function");
+        for (const auto& [name, counts] : rows)
+            os << std::format("{:>8.2f} {:>8.2f} {:>10}  {}\n", percent(counts.first), percent(counts.second), counts.first, name);
+    }
+};
+
+
+inline std::unique_ptr<Profiler>& profiler() {
+    static std::unique_ptr<Profiler> p;
+    return p;
+}
+
+
+// pushes a frame for as long as it lives, if profiling is on.
+// the name is only computed when it's needed, so when profiling is off this is a single null check
+class ProfileFrame {
+    Profiler* p{};
+
+public:
+    template <std::invocable F>
+    explicit ProfileFrame(F&& name) {
+        if (const auto& prof = profiler(); prof) [[unlikely]] {
+            p = prof.get();
+            p->enter(std::string{name()});
+        }
+    }
+
+    ProfileFrame(const ProfileFrame&) = delete;
+    ProfileFrame& operator=(const ProfileFrame&) = delete;
+
+    ~ProfileFrame() { if (p) p->leave(); }
+};
+
+
+} // namespace util
+} // namespace pie
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../Lex/Lexer.hxx"
+#include "../Preprocessor/Preprocessor.hxx"
+#include "../Parser/Parser.hxx"
+#include "../Analysis/LexicalScoping.hxx"
+#include "../Interp/Interpreter.hxx"
+
+
+inline namespace pie {
+
+
+// * incremental session * //
+// the REPL (or anything that keeps feeding code into the same program) goes through one of these.
+// the parser, the scope tables of the analysis, and the interpreter all live as long as the session,
+// so every new snippet is only lexed, parsed and analysed on its own, on top of everything that came before it
+class Session {
+    const std::filesystem::path root;
+
+    Preprocessor preprocessor;
+    Parser parser;
+    analysis::LexicalAnalysis anal;
+    interp::Visitor visitor;
+
+    Tokens tokens; // reused for every snippet
+
+public:
+    explicit Session(std::filesystem::path root = ".") : root{root}, parser{std::move(root)} {}
+
+
+    // every snippet may import the same module again, so the modules pasted into the last one are forgotten
+    [[nodiscard]] std::string preprocess(const std::string_view src) {
+        preprocessor.forget();
+        return preprocessor.process(src, root);
+    }
+
+
+    const Tokens& lex(const std::string_view src) {
+        lex::lex(src, tokens);
+        return tokens;
+    }
+
+
+    // parses and analyses whatever was just lexed, without running it
+    [[nodiscard]] std::vector<expr::ExprPtr> compile() {
+        if (tokens.empty()) return {};
+
+        auto [exprs, ops] = parser.parse(std::move(tokens));
+        visitor.addOperators(std::move(ops)); // only the new ones
+
+        for (const auto& expr : exprs)
+            std::visit(anal, expr->variant());
+
+        return exprs;
+    }
+
+
+    // value of the last expression, if there was any
+    std::optional<Value> run(const std::vector<expr::ExprPtr>& exprs) {
+        if (exprs.empty()) return {};
+
+        Value value;
+        for (const auto& expr : exprs) value = std::visit(visitor, expr->variant());
+
+        return value;
+    }
+
+
+    std::optional<Value> eval(const std::string_view src) {
+        lex(src);
+        return run(compile());
+    }
+};
+
+
+} // namespace pie
@@ -12,6 +12,12 @@
 #include <concepts>
 #include <type_traits>
 #include <stdexcept>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <string_view>
+#include <utility>
 
 #include "../Lex/Token.hxx"
 
@@ -21,12 +27,97 @@ inline namespace pie {
 namespace util {
 
 
+// * stdout sink * //
+// everything a program prints goes through one big buffer and only reaches stdout when it fills up,
+// or at a flush point: end of the program, before reading input, on errors (and after every print when unbuffered)
+class Output {
+    static constexpr size_t capacity = 1 << 16;
+
+    std::unique_ptr<char[]> buffer = std::make_unique<char[]>(capacity);
+    size_t used{};
+
+    void drain() {
+        if (used) std::fwrite(buffer.get(), 1, used, stdout);
+        used = 0;
+    }
+
+public:
+    bool unbuffered = false;
+
+    Output() = default;
+    Output(const Output&) = delete;
+    Output& operator=(const Output&) = delete;
+
+    ~Output() { flush(); }
+
+
+    void write(const std::string_view s) {
+        if (s.size() > capacity - used) {
+            drain();
+
+            // doesn't fit even when empty. no point copying it
+            if (s.size() >= capacity) {
+                std::fwrite(s.data(), 1, s.size(), stdout);
+                return;
+            }
+        }
+
+        std::memcpy(buffer.get() + used, s.data(), s.size());
+        used += s.size();
+    }
+
+    void write(const char c) {
+        if (used == capacity) drain();
+        buffer[used++] = c;
+    }
+
+    // formatted right into the buffer, no temporary strings
+    void write(const long long n) {
+        char digits[24];
+        const auto [end, _] = std::to_chars(digits, digits + sizeof digits, n);
+        write(std::string_view{digits, end});
+    }
+
+    void write(const double d) {
+        char digits[512]; // enough for DBL_MAX in fixed notation
+        const auto [end, _] = std::to_chars(digits, digits + sizeof digits, d, std::chars_format::fixed, 6); // same as std::to_string
+        write(std::string_view{digits, end});
+    }
+
+
+    void flush() {
+        drain();
+        std::fflush(stdout);
+    }
+};
+
+inline Output& out() {
+    static Output output;
+    return output;
+}
+
+
+
+// while one of these is alive, errors on this thread just throw. Nothing is flushed or printed.
+// for work whose failures are caught and reported later by someone else (like module preloading on worker threads)
+inline thread_local bool quiet_errors = false;
+
+struct QuietErrors {
+    const bool was = std::exchange(quiet_errors, true);
+    ~QuietErrors() { quiet_errors = was; }
+};
+
+
 template <typename Except = std::runtime_error, bool print_loc = true>
 [[noreturn]] inline void error(
     const std::string_view msg = "[no diagnostic]. If you see this, please file a bug report!",
     [[maybe_unused]] const std::source_location& location = std::source_location::current()
 )
 {
+    if (quiet_errors) throw Except{std::string{msg}};
+
+    out().flush(); // whatever the program printed before dying should come out before the error
+
     #if not NO_ERR_LOC
     if constexpr (print_loc)
         std::print(std::cerr, "\033[1m{}:{}:{}: \033[31merror:\033[0m ", location.file_name(), location.line(), location.column());
@@ -68,15 +159,28 @@ Deferred(F) -> Deferred<F>;
 
 
 
+// sizes the buffer up front and reads straight into it. No stringstream in between
+[[nodiscard]] inline std::string readAll(std::ifstream& fin) {
+    fin.seekg(0, std::ios::end);
+    const auto size = fin.tellg();
+    fin.seekg(0, std::ios::beg);
+
+    if (size <= 0) return {};
+
+    std::string src(static_cast<size_t>(size), '\0');
+    fin.read(src.data(), size);
+    src.resize(static_cast<size_t>(fin.gcount()));
+
+    return src;
+}
+
+
 [[nodiscard]] inline std::string readFile(const std::string& fname) {
-    const std::ifstream fin{fname};
+    std::ifstream fin{fname, std::ios::binary};
 
     if (not fin.is_open()) error("File \"" + fname + " \" not found!");
 
-    std::stringstream ss;
-    ss << fin.rdbuf();
-
-    return ss.str();
+    return readAll(fin);
 }
 
 
@@ -1,6 +1,8 @@
 #include <string>
 #include <string_view>
 #include <filesystem>
+#include <memory>
+#include <chrono>
 
 
 #include "Utils/CLI.hxx"
@@ -30,6 +32,13 @@ int main(int argc, char *argv[]) {
         else if (argv[1] == "-help"sv ) print_help         = true ;
         else if (argv[1] == "-run"sv  ) run                = false;
         else if (argv[1] == "-repl"sv ) repl               = true ;
+        else if (argv[1] == "-unbuffered"sv) pie::util::out().unbuffered = true;
+        else if (argv[1] == "-profile"sv) pie::util::profiler() = std::make_unique<pie::util::Profiler>(std::chrono::milliseconds{1});
+        else if (argv[1] == "-profile-calls"sv) pie::util::profiler() = std::make_unique<pie::util::Profiler>();
+        else if (argv[1] == "-count"sv) pie::util::counters() = std::make_unique<pie::util::Counters>();
+        else if (argv[1] == "-O0"sv) pie::analysis::optimization() = 0;
+        else if (argv[1] == "-O1"sv) pie::analysis::optimization() = 1;
+        else if (argv[1] == "-opt-report"sv) pie::analysis::optimizationReport() = true;
         else fname = argv[1];
     }
 
@@ -48,10 +57,13 @@ int main(int argc, char *argv[]) {
         );
     }
     else try {
-        pie::cli::runFile(std::move(fname), print_preprocessed, print_tokens, print_parsed, run);
+        pie::cli::runFile(fname, print_preprocessed, print_tokens, print_parsed, run);
     }
     catch(const std::exception& e) {
+        pie::util::out().flush();
         std::cerr << e.what() << std::endl;
+
+        if (run) pie::cli::report(fname); // what was counted or profiled up to the error
         return 1;
     }
 }
\ No newline at end of file